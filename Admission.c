@@ -0,0 +1,150 @@
+/*
+ * @file    Admission.c
+ * @brief   Contains the schedulability analysis used by admission
+ *          control and its UART report
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_ADMISSION
+#include <stdio.h>
+#include "Admission.h"
+#include "KernelCall.h"
+#include "Process.h"
+#include "EDF.h"
+#include "UART.h"
+#include "Utilities.h"
+
+#define SCHED_LINE  96
+
+/*
+ * @brief   Worst case response time of a fixed priority task: the
+ *          smallest fixed point of R = C + sum(ceil(R / Tj) * Cj) over
+ *          every other task that can run ahead of it
+ * @param   [in] TaskTiming * table: tasks analysed
+ *          [in] int count: number of tasks in table
+ *          [in] int task: index of the task of interest
+ * @return  unsigned long: response time, or the first iterate past the
+ *          task's deadline if it cannot meet it
+ */
+PRIVATE unsigned long responseTime(TaskTiming * table, int count, int task)
+{
+    unsigned long response = table[task].wcet;
+    unsigned long previous = 0;
+    int i;
+
+    while(response != previous && response <= table[task].deadline)
+    {
+        previous = response;
+        response = table[task].wcet;
+        for(i = 0; i < count; i++)
+        {
+            if(i != task && table[i].priority >= table[task].priority)
+            {
+                response += ((previous + table[i].period - 1) / table[i].period) * table[i].wcet;
+            }
+        }
+    }
+    return response;
+}
+
+/*
+ * @brief   Runs the analysis over a set of timed tasks, filling in
+ *          the response and schedulable fields of each
+ * @param   [in/out] TaskTiming * table: tasks analysed
+ *          [in] int count: number of tasks in table
+ *          [out] unsigned long * density: sum of WCET / deadline of the
+ *                EDF tasks, scaled by DENSITY_ONE and rounded up
+ * @return  int: TRUE if every task meets its deadlines
+ */
+int analyseTasks(TaskTiming * table, int count, unsigned long * density)
+{
+    unsigned long long sum = 0;
+    int result = TRUE;
+    int i;
+
+    for(i = 0; i < count; i++)
+    {
+        if(table[i].priority == EDF_PRIORITY)
+        {
+            sum += (((unsigned long long)table[i].wcet << DENSITY_SHIFT) +
+                    table[i].deadline - 1) / table[i].deadline;
+        }
+    }
+    *density = (sum > DENSITY_ONE) ? DENSITY_ONE + 1 : (unsigned long)sum;
+
+    for(i = 0; i < count; i++)
+    {
+        if(table[i].priority == EDF_PRIORITY)
+        {
+            table[i].response = 0;
+            table[i].schedulable = (*density <= DENSITY_ONE);
+        }
+        else
+        {
+            table[i].response = responseTime(table, count, i);
+            table[i].schedulable = (table[i].response <= table[i].deadline);
+        }
+        result = result && table[i].schedulable;
+    }
+    return result;
+}
+
+/*
+ * @brief   Writes a string to UART0
+ * @param   [in] char * string: NUL terminated string to write
+ */
+PRIVATE void schedString(char * string)
+{
+    while(*string)
+    {
+        forceOutput(*(string++));
+    }
+}
+
+/*
+ * @brief   Analyses the registered timed processes and writes the
+ *          report described in Admission.h. Called from a process.
+ */
+void schedulabilityReport(void)
+{
+    ProcessStats processes[ADMISSION_TASKS];
+    TaskTiming table[ADMISSION_TASKS];
+    char line[SCHED_LINE];
+    unsigned long density;
+    int count = 0;
+    int entries;
+    int result;
+    int i;
+
+    entries = ps(processes, ADMISSION_TASKS);
+    for(i = 0; i < entries; i++)
+    {
+        if(processes[i].period)
+        {
+            table[count].pid = processes[i].pid;
+            table[count].priority = processes[i].basePriority;
+            table[count].period = processes[i].period;
+            table[count].wcet = processes[i].wcet;
+            table[count].deadline = processes[i].relativeDeadline;
+            count++;
+        }
+    }
+    result = analyseTasks(table, count, &density);
+
+    sprintf(line, "\r\nSCHED,BEGIN,%d\r\n", count);
+    schedString(line);
+    for(i = 0; i < count; i++)
+    {
+        sprintf(line, "SCHED,TASK,%u,%c,%d,%lu,%lu,%lu,%lu,%s\r\n", table[i].pid,
+                (table[i].priority == EDF_PRIORITY) ? 'E' : 'F', table[i].priority,
+                table[i].period, table[i].wcet, table[i].deadline, table[i].response,
+                (table[i].schedulable) ? "OK" : "FAIL");
+        schedString(line);
+    }
+    sprintf(line, "SCHED,EDF,%lu,%s\r\n", (density * 1000 + DENSITY_ONE - 1) >> DENSITY_SHIFT,
+            (density <= DENSITY_ONE) ? "OK" : "FAIL");
+    schedString(line);
+    sprintf(line, "SCHED,END,%s\r\n", (result) ? "OK" : "FAIL");
+    schedString(line);
+}
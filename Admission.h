@@ -0,0 +1,54 @@
+/*
+ * @file    Admission.h
+ * @brief   Admission control for timed processes.
+ *          registerTimedProcess() registers a process with a period,
+ *          worst case execution time (WCET) and relative deadline, in
+ *          SysTick ticks, only if every timed process would still meet
+ *          its deadlines:
+ *              EDF class   density test, sum of WCET / deadline <= 1
+ *              fixed       response time analysis; EDF processes and
+ *                          fixed ones of equal or higher priority
+ *                          interfere
+ *          Processes registered without timing are not analysed.
+ *          schedulabilityReport() writes the analysis of the registered
+ *          timed processes to UART0, one CSV line each:
+ *              SCHED,BEGIN,<tasks>
+ *              SCHED,TASK,<pid>,<E|F>,<priority>,<period>,<wcet>,<deadline>,<response>,<OK|FAIL>
+ *              SCHED,EDF,<density in 1/1000>,<OK|FAIL>
+ *              SCHED,END,<OK|FAIL>
+ *          tools/schedulability.py produces the same report on the host
+ *          from a process table.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+
+/* Most timed processes analysed at once */
+#define ADMISSION_TASKS     16
+/* Fixed point scale of the EDF density sum */
+#define DENSITY_SHIFT       20
+#define DENSITY_ONE         (1UL << DENSITY_SHIFT)
+
+/*
+ * @brief   Task Timing Structure
+ * @details One timed process as seen by the analysis
+ */
+typedef struct TaskTiming_
+{
+    unsigned int pid;
+    int priority;//fixed priority, or EDF_PRIORITY
+    unsigned long period;
+    unsigned long wcet;
+    unsigned long deadline;
+    unsigned long response;//[out] worst case response time, 0 for EDF
+    int schedulable;//[out] TRUE if the task meets its deadline
+}TaskTiming;
+
+#ifndef GLOBAL_ADMISSION
+#define GLOBAL_ADMISSION
+
+extern int analyseTasks(TaskTiming *, int, unsigned long *);
+extern void schedulabilityReport(void);
+
+#endif /* GLOBAL_ADMISSION */
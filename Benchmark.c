@@ -0,0 +1,1151 @@
+/*
+ * @file    Benchmark.c
+ * @brief   Messaging and scheduling benchmark processes.
+ *          A driver process runs each test against an echo process of
+ *          the same priority and a higher priority wake process, timing
+ *          operations with the DWT cycle counter:
+ *              roundtrip   send + receive with a switch each way
+ *              selfloop    send to own mailbox + receive, no switch
+ *              switch      (roundtrip - fastest selfloop) / 2
+ *              bridge      round trip to the echo process through the
+ *                          bridge and its looped back link, and cycles
+ *                          per message of bursts through it
+ *              rpc         rpcCall() to the echo process, and calls
+ *                          kept 4 outstanding with rpcSend()/rpcWait()
+ *              throughput  cycles per message sent, per message size
+ *              channel     cycles per channelWrite() streaming to a
+ *                          reader process, per write size
+ *              workers     cycles per job through a mailbox shared by
+ *                          1 to 4 spawned workers, each job a one tick
+ *                          wait on a timer
+ *              pipe        cycles per transfer of 1 KB to 64 KB through
+ *                          a pipe to a reader process, per size
+ *              recvany     receive with ANY, per number of mailboxes
+ *                          bound, each holding a message
+ *              bind/unbind cost of binding any mailbox and releasing it
+ *              lookup      resolving a mailbox name in the kernel, and
+ *                          from the thread mode lookup cache
+ *              overload    send to a mailbox at its limit, per drop
+ *                          policy (enum overloadpolicies)
+ *              wake        send to a blocked higher priority process
+ *                          until it runs
+ *              event       eventSet() waking the same process from
+ *                          eventWait() until it runs, and setting and
+ *                          taking the driver's own flag without blocking
+ *              mutex       lock and unlock with no other process
+ *                          waiting, and an unlock handing the mutex to
+ *                          the waiting wake process until it runs
+ *              semaphore   wait and signal with no other process
+ *                          waiting
+ *              spawn       spawn() of a worker that exits at once, to
+ *                          join() returning its code, per worker
+ *                          priority: above the driver (the worker has
+ *                          exited before join()) and below (join()
+ *                          blocks until it has)
+ *              schedlat    send to an interactive process sharing its
+ *                          priority with CPU-bound ones until it runs,
+ *                          under fixed priority rotation and MLFQ
+ *              irqlat      worst and mean entry latency of the
+ *                          kernel-aware and zero-latency interrupt
+ *                          probes over the whole run
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_BENCHMARK
+#include <stdio.h>
+#include <string.h>
+#include "Benchmark.h"
+#include "KernelCall.h"
+#include "SVC.h"
+#include "UART.h"
+#include "Console.h"
+#include "Utilities.h"
+#include "DWT.h"
+#include "MLFQ.h"
+#include "Timer.h"
+#include "Interrupts.h"
+#include "Spawn.h"
+#include "Channel.h"
+#include "Pipe.h"
+#include "Rpc.h"
+#include "Names.h"
+#include "Bridge.h"
+#include "Events.h"
+#include "Sync.h"
+
+#define BENCH_LINE  64
+
+/* Filled in by the wake process, read by the driver between tests */
+PRIVATE BenchResult wakeResult;
+/* CYCLE_COUNT() when the driver last set the wake process' event flag
+ * or unlocked the mutex it waits on */
+PRIVATE volatile unsigned long wakeStamp;
+/* Locked by the driver and the wake process in the mutex test */
+PRIVATE Mutex sharedMutex;
+/* Filled in by the interactive process */
+PRIVATE BenchResult schedResult;
+/* TRUE while the hog processes are to keep the CPU busy */
+PRIVATE volatile int hogsRun = FALSE;
+/* Ring streamed through by the channel test */
+PRIVATE Channel benchChannel;
+PRIVATE unsigned char channelBuffer[BENCH_CHANNEL_CAPACITY];
+/* Writing end of the pipe test, held by the driver */
+PRIVATE Pipe benchPipe;
+
+/*
+ * @brief   Clears a result before a test
+ * @param   [out] BenchResult * result: result to clear
+ */
+void benchReset(BenchResult * result)
+{
+    result->samples = 0;
+    result->min = (unsigned long)-1;
+    result->max = 0;
+    result->total = 0;
+}
+
+/*
+ * @brief   Adds one sample to a result
+ * @param   [in/out] BenchResult * result: result being accumulated
+ *          [in] unsigned long cycles: cycles taken by one operation
+ */
+void benchRecord(BenchResult * result, unsigned long cycles)
+{
+    result->samples++;
+    result->total += cycles;
+    result->min = (cycles < result->min) ? cycles : result->min;
+    result->max = (cycles > result->max) ? cycles : result->max;
+}
+
+/*
+ * @brief   Writes a string to UART0. forceOutput() is used so
+ *          reporting does not go through the messaging being measured.
+ * @param   [in] char * string: NUL terminated string to write
+ */
+PRIVATE void benchString(char * string)
+{
+    while(*string)
+    {
+        forceOutput(*(string++));
+    }
+}
+
+/*
+ * @brief   Writes one result line to UART0, or in binary console mode
+ *          a CONSOLE_BENCH record
+ * @param   [in] char * test: name of the test
+ *          [in] int parameter: message size, mailbox count, or 0
+ *          [in] BenchResult * result: result to report
+ */
+void benchReport(char * test, int parameter, BenchResult * result)
+{
+    char line[BENCH_LINE];
+    unsigned long mean = (result->samples) ? result->total / result->samples : 0;
+
+    if(getConsoleMode() == CONSOLE_BINARY)
+    {
+        consoleBegin(CONSOLE_BENCH);
+        consoleNumber(parameter);
+        consoleNumber(result->samples);
+        consoleNumber((result->samples) ? result->min : 0);
+        consoleNumber(mean);
+        consoleNumber(result->max);
+        consoleBytes(test, strlen(test));
+        consoleEnd();
+        return;
+    }
+
+    sprintf(line, "BENCH,%s,%d,%lu,%lu,%lu,%lu\r\n", test, parameter, result->samples,
+            (result->samples) ? result->min : 0, mean, result->max);
+    benchString(line);
+}
+
+/*
+ * @brief   Writes the BEGIN marker, with the number of samples each
+ *          latency test takes
+ */
+PRIVATE void benchBegin(void)
+{
+    char line[BENCH_LINE];
+
+    sprintf(line, "\r\nBENCH,BEGIN,%d\r\n", BENCH_ITERATIONS);
+    benchString(line);
+}
+
+/*
+ * @brief   Times messages to the echo process and back. A round trip
+ *          does the work of the self loop plus two switches, so each
+ *          sample less the fastest self loop, halved, is also recorded
+ *          as a switch sample.
+ * @param   [out] BenchResult * result: round trip times
+ *          [out] BenchResult * switchResult: context switch times
+ *          [in] unsigned long selfLoop: fastest self loop in cycles
+ */
+PRIVATE void benchRoundTrip(BenchResult * result, BenchResult * switchResult, unsigned long selfLoop)
+{
+    BenchCommand command;
+    int fromMB;
+    int i;
+    unsigned long start;
+    unsigned long cycles;
+
+    benchReset(result);
+    benchReset(switchResult);
+    command.op = BENCH_ECHO;
+    command.replyMB = BENCH_DRIVER_MB;
+    command.stamp = 0;
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start = CYCLE_COUNT();
+        sendMessage(BENCH_ECHO_MB, BENCH_DRIVER_MB, &command, sizeof(BenchCommand));
+        recvMessage(BENCH_DRIVER_MB, &fromMB, &command, sizeof(BenchCommand));
+        cycles = CYCLE_COUNT() - start;
+        benchRecord(result, cycles);
+        benchRecord(switchResult, (cycles > selfLoop) ? (cycles - selfLoop) / 2 : 0);
+    }
+}
+
+/*
+ * @brief   Times the echo process through the bridge: round trips, then
+ *          bursts of BENCH_BATCH one-way messages of BRIDGE_LIMIT bytes
+ *          each followed by an ack, per message. The link is looped back
+ *          unless HOST_LINK joins it to another node running the suite,
+ *          whose echo process answers instead.
+ * @param   [out] BenchResult * roundTrip: round trip times
+ *          [out] BenchResult * flow: cycles per message of a burst
+ */
+PRIVATE void benchBridge(BenchResult * roundTrip, BenchResult * flow)
+{
+    char contents[BRIDGE_LIMIT];
+    BenchCommand command;
+    int echoMB;
+    int fromMB;
+    int timer;
+    int batch;
+    int i;
+    unsigned long start;
+
+    benchReset(roundTrip);
+    benchReset(flow);
+    /* Let every process bind its mailbox, and the bridge name its
+     * own, before the bridge binds proxies with any free mailbox */
+    timerStart(BENCH_DRIVER_MB, 1, FALSE);
+    recvMessage(BENCH_DRIVER_MB, &fromMB, contents, BRIDGE_LIMIT);
+    echoMB = bridgeProxy(BENCH_ECHO_MB);
+    if(echoMB < 0)
+    {
+        return;
+    }
+
+    command.op = BENCH_ECHO;
+    command.replyMB = BENCH_DRIVER_MB;
+    command.stamp = 0;
+    /* The other node may not be running yet: repeat until answered */
+    do
+    {
+        sendMessage(echoMB, BENCH_DRIVER_MB, &command, sizeof(BenchCommand));
+        timer = timerStart(BENCH_DRIVER_MB, BENCH_BRIDGE_RETRY, FALSE);
+        recvMessage(BENCH_DRIVER_MB, &fromMB, contents, BRIDGE_LIMIT);
+    } while(fromMB == TIMER_SOURCE);
+    if(timerCancel(timer) != SUCCESS)
+    {
+        /* It expired as the answer came */
+        recvMessage(BENCH_DRIVER_MB, &fromMB, contents, BRIDGE_LIMIT);
+    }
+
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start = CYCLE_COUNT();
+        sendMessage(echoMB, BENCH_DRIVER_MB, &command, sizeof(BenchCommand));
+        recvMessage(BENCH_DRIVER_MB, &fromMB, &command, sizeof(BenchCommand));
+        benchRecord(roundTrip, CYCLE_COUNT() - start);
+    }
+
+    memset(contents, 0, BRIDGE_LIMIT);
+    contents[0] = BENCH_SINK;
+    command.op = BENCH_ACK;
+    for(batch = 0; batch < BENCH_BATCHES; batch++)
+    {
+        start = CYCLE_COUNT();
+        for(i = 0; i < BENCH_BATCH; i++)
+        {
+            sendMessage(echoMB, BENCH_DRIVER_MB, contents, BRIDGE_LIMIT);
+        }
+        sendMessage(echoMB, BENCH_DRIVER_MB, &command, sizeof(BenchCommand));
+        recvMessage(BENCH_DRIVER_MB, &fromMB, &command, sizeof(BenchCommand));
+        benchRecord(flow, (CYCLE_COUNT() - start) / BENCH_BATCH);
+    }
+}
+
+/*
+ * @brief   Times finding the echo process' mailbox by name
+ * @param   [out] BenchResult * result: cycles per lookup
+ *          [in] int cached: TRUE for lookupName(), FALSE for resolveName()
+ */
+PRIVATE void benchLookup(BenchResult * result, int cached)
+{
+    int i;
+    unsigned long start;
+
+    benchReset(result);
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start = CYCLE_COUNT();
+        if(((cached) ? lookupName(BENCH_ECHO_NAME) : resolveName(BENCH_ECHO_NAME)) == BENCH_ECHO_MB)
+        {
+            benchRecord(result, CYCLE_COUNT() - start);
+        }
+    }
+}
+
+/*
+ * @brief   Times calls to the echo process through the RPC layer,
+ *          one at a time with rpcCall() or several outstanding, their
+ *          replies collected newest first
+ * @param   [out] BenchResult * result: cycles per call
+ *          [in] int outstanding: calls in flight, up to BENCH_RPC_OUTSTANDING
+ */
+PRIVATE void benchRpc(BenchResult * result, int outstanding)
+{
+    BenchCommand command;
+    int callIds[BENCH_RPC_OUTSTANDING];
+    int i;
+    int j;
+    unsigned long start;
+
+    benchReset(result);
+    command.op = BENCH_ECHO;
+    command.replyMB = BENCH_DRIVER_MB;
+    command.stamp = 0;
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start = CYCLE_COUNT();
+        if(outstanding == 1)
+        {
+            rpcCall(BENCH_ECHO_MB, &command, sizeof(BenchCommand), &command, sizeof(BenchCommand));
+        }
+        else
+        {
+            for(j = 0; j < outstanding; j++)
+            {
+                callIds[j] = rpcSend(BENCH_ECHO_MB, &command, sizeof(BenchCommand));
+            }
+            for(j = outstanding - 1; j >= 0; j--)
+            {
+                rpcWait(callIds[j], &command, sizeof(BenchCommand));
+            }
+        }
+        benchRecord(result, (CYCLE_COUNT() - start) / outstanding);
+    }
+}
+
+/*
+ * @brief   Times receives with ANY while every one of the driver's
+ *          mailboxes holds a message. Each mailbox is primed with one
+ *          message and the one received is refilled straight away,
+ *          so the receive never blocks and always chooses among all
+ *          of them.
+ * @param   [out] BenchResult * result: receive times
+ *          [in] int * mailBoxList: the driver's mailboxes
+ *          [in] int mailBoxes: number of entries in mailBoxList
+ */
+PRIVATE void benchReceiveAny(BenchResult * result, int * mailBoxList, int mailBoxes)
+{
+    BenchCommand command;
+    int fromMB;
+    int i;
+    unsigned long start;
+
+    benchReset(result);
+    command.op = BENCH_SINK;
+    command.stamp = 0;
+    for(i = 0; i < mailBoxes; i++)
+    {
+        sendMessage(mailBoxList[i], mailBoxList[i], &command, sizeof(BenchCommand));
+    }
+
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start = CYCLE_COUNT();
+        recvMessage(ANY, &fromMB, &command, sizeof(BenchCommand));
+        benchRecord(result, CYCLE_COUNT() - start);
+        sendMessage(fromMB, fromMB, &command, sizeof(BenchCommand));
+    }
+
+    /* Drain the messages still pending */
+    for(i = 0; i < mailBoxes; i++)
+    {
+        recvMessage(ANY, &fromMB, &command, sizeof(BenchCommand));
+    }
+}
+
+/*
+ * @brief   Times a send to the driver's own mailbox followed by its
+ *          receive, which never blocks or switches
+ * @param   [out] BenchResult * result: send + receive times
+ */
+PRIVATE void benchSelfLoop(BenchResult * result)
+{
+    BenchCommand command;
+    int fromMB;
+    int i;
+    unsigned long start;
+
+    benchReset(result);
+    command.op = BENCH_ECHO;
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start = CYCLE_COUNT();
+        sendMessage(BENCH_DRIVER_MB, BENCH_DRIVER_MB, &command, sizeof(BenchCommand));
+        recvMessage(BENCH_DRIVER_MB, &fromMB, &command, sizeof(BenchCommand));
+        benchRecord(result, CYCLE_COUNT() - start);
+    }
+}
+
+/*
+ * @brief   Times batches of one-way messages of one size; the echo
+ *          process drains them once the driver blocks for its ack
+ * @param   [out] BenchResult * result: cycles per message
+ *          [in] int size: message size in bytes
+ */
+PRIVATE void benchThroughput(BenchResult * result, int size)
+{
+    char contents[MESSAGE_SYS_LIMIT];
+    BenchCommand command;
+    int fromMB;
+    int batch;
+    int i;
+    unsigned long start;
+
+    benchReset(result);
+    memset(contents, 0, MESSAGE_SYS_LIMIT);
+    contents[0] = BENCH_SINK;
+    command.op = BENCH_ACK;
+    command.replyMB = BENCH_DRIVER_MB;
+    for(batch = 0; batch < BENCH_BATCHES; batch++)
+    {
+        start = CYCLE_COUNT();
+        for(i = 0; i < BENCH_BATCH; i++)
+        {
+            sendMessage(BENCH_ECHO_MB, BENCH_DRIVER_MB, contents, size);
+        }
+        sendMessage(BENCH_ECHO_MB, BENCH_DRIVER_MB, &command, sizeof(BenchCommand));
+        recvMessage(BENCH_DRIVER_MB, &fromMB, &command, sizeof(BenchCommand));
+        benchRecord(result, (CYCLE_COUNT() - start) / BENCH_BATCH);
+    }
+}
+
+/*
+ * @brief   Times streaming through a channel to the reader process,
+ *          which acknowledges each BENCH_CHANNEL_BYTES it has read
+ * @param   [out] BenchResult * result: cycles per write
+ *          [in] int size: bytes per channelWrite()
+ */
+PRIVATE void benchChannelStream(BenchResult * result, int size)
+{
+    unsigned char contents[BENCH_CHANNEL_MAX_WRITE];
+    BenchCommand command;
+    int fromMB;
+    int batch;
+    int i;
+    unsigned long start;
+
+    benchReset(result);
+    memset(contents, 0, size);
+    for(batch = 0; batch < BENCH_BATCHES; batch++)
+    {
+        start = CYCLE_COUNT();
+        for(i = 0; i < BENCH_CHANNEL_BYTES / size; i++)
+        {
+            channelWrite(&benchChannel, contents, size);
+        }
+        recvMessage(BENCH_DRIVER_MB, &fromMB, &command, sizeof(BenchCommand));
+        benchRecord(result, (CYCLE_COUNT() - start) / (BENCH_CHANNEL_BYTES / size));
+    }
+}
+
+/*
+ * @brief   Times transfers through a pipe to the pipe process, each
+ *          written BENCH_PIPE_WRITE bytes at a time and closed; the
+ *          reader acknowledges when it reaches the end of the stream
+ * @param   [out] BenchResult * result: cycles per transfer
+ *          [in] int size: bytes per transfer
+ */
+PRIVATE void benchPipeStream(BenchResult * result, int size)
+{
+    unsigned char contents[BENCH_PIPE_WRITE];
+    BenchCommand command;
+    int fromMB;
+    int transfer;
+    int i;
+    unsigned long start;
+
+    benchReset(result);
+    memset(contents, 0, BENCH_PIPE_WRITE);
+    for(transfer = 0; transfer < BENCH_PIPE_TRANSFERS; transfer++)
+    {
+        start = CYCLE_COUNT();
+        for(i = 0; i < size / BENCH_PIPE_WRITE; i++)
+        {
+            pipeWrite(&benchPipe, contents, BENCH_PIPE_WRITE);
+        }
+        pipeClose(&benchPipe);
+        recvMessage(BENCH_DRIVER_MB, &fromMB, &command, sizeof(BenchCommand));
+        benchRecord(result, CYCLE_COUNT() - start);
+    }
+}
+
+/*
+ * @brief   Times binding any free mailbox and releasing it
+ * @param   [out] BenchResult * bindResult: bind(ANY) times
+ *          [out] BenchResult * unbindResult: unbind() times
+ */
+PRIVATE void benchBind(BenchResult * bindResult, BenchResult * unbindResult)
+{
+    int mailBox;
+    int i;
+    unsigned long start;
+
+    benchReset(bindResult);
+    benchReset(unbindResult);
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start = CYCLE_COUNT();
+        mailBox = bind(ANY);
+        benchRecord(bindResult, CYCLE_COUNT() - start);
+
+        start = CYCLE_COUNT();
+        unbind(mailBox);
+        benchRecord(unbindResult, CYCLE_COUNT() - start);
+    }
+}
+
+/*
+ * @brief   Times sends to a mailbox of the driver at its limit under a
+ *          policy that drops or replaces, each send keyed by its leading
+ *          int; the sample is discarded unless the send was dropped
+ * @param   [out] BenchResult * result: cycles per send
+ *          [in] int policy: MB_OVERLOAD_DROP_OLDEST, _DROP_NEWEST or _LATEST
+ */
+PRIVATE void benchOverload(BenchResult * result, int policy)
+{
+    MailBoxStats stats;
+    unsigned long dropped;
+    int contents[2];
+    int mailBox = bind(ANY);
+    int fromMB;
+    int i;
+    unsigned long start;
+
+    benchReset(result);
+    mailboxControl(mailBox, MB_OPT_LIMIT, BENCH_OVERLOAD_LIMIT);
+    mailboxControl(mailBox, MB_OPT_OVERLOAD, policy);
+    contents[1] = 0;
+    for(i = 0; i < BENCH_OVERLOAD_LIMIT; i++)
+    {
+        contents[0] = i;
+        sendMessage(mailBox, BENCH_DRIVER_MB, contents, sizeof(contents));
+    }
+
+    getMailBoxStats(mailBox, &stats);
+    dropped = stats.dropped;
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        contents[0] = i % BENCH_OVERLOAD_LIMIT;
+        start = CYCLE_COUNT();
+        sendMessage(mailBox, BENCH_DRIVER_MB, contents, sizeof(contents));
+        benchRecord(result, CYCLE_COUNT() - start);
+    }
+
+    getMailBoxStats(mailBox, &stats);
+    if(stats.dropped - dropped != BENCH_ITERATIONS || stats.depth != BENCH_OVERLOAD_LIMIT)
+    {
+        benchReset(result);
+    }
+    for(i = 0; i < BENCH_OVERLOAD_LIMIT; i++)
+    {
+        recvMessage(mailBox, &fromMB, contents, sizeof(contents));
+    }
+    unbind(mailBox);
+}
+
+/*
+ * @brief   Times sends that wake the higher priority wake process;
+ *          it has run and recorded the latency by the time
+ *          sendMessage() returns
+ */
+PRIVATE void benchWake(void)
+{
+    BenchCommand command;
+    int i;
+
+    benchReset(&wakeResult);
+    command.op = BENCH_SINK;
+    command.replyMB = BENCH_DRIVER_MB;
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        command.stamp = CYCLE_COUNT();
+        sendMessage(BENCH_WAKE_MB, BENCH_DRIVER_MB, &command, sizeof(BenchCommand));
+    }
+}
+
+/*
+ * @brief   Times eventSet() waking the wake process, which waits on its
+ *          flag once told to with a BENCH_EVENTS message, and the cost of
+ *          an eventSet() and eventWait() that do not block
+ * @param   [out] BenchResult * result: cycles per set and wait of the
+ *          driver's own flag; the wake latency goes to wakeResult
+ */
+PRIVATE void benchEvent(BenchResult * result)
+{
+    BenchCommand command;
+    unsigned long start;
+    int pid = getid();
+    int i;
+
+    benchReset(&wakeResult);
+    command.op = BENCH_EVENTS;
+    command.replyMB = BENCH_DRIVER_MB;
+    sendMessage(BENCH_WAKE_MB, BENCH_DRIVER_MB, &command, sizeof(BenchCommand));
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        wakeStamp = CYCLE_COUNT();
+        eventSet(BENCH_WAKE_PID, BENCH_WAKE_EVENT);
+    }
+
+    benchReset(result);
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start = CYCLE_COUNT();
+        eventSet(pid, BENCH_WAKE_EVENT);
+        if(eventWait(BENCH_WAKE_EVENT, EVENT_ANY, EVENT_POLL) == BENCH_WAKE_EVENT)
+        {
+            benchRecord(result, CYCLE_COUNT() - start);
+        }
+    }
+}
+
+/*
+ * @brief   Times an uncontended mutexLock()/mutexUnlock() pair, which
+ *          never enters the kernel, then unlocks handing the mutex to
+ *          the wake process: told to with a BENCH_MUTEX message, it
+ *          locks after each event flag the driver sets while holding it
+ * @param   [out] BenchResult * result: cycles per uncontended pair; the
+ *          handover latency goes to wakeResult
+ */
+PRIVATE void benchMutex(BenchResult * result)
+{
+    BenchCommand command;
+    unsigned long start;
+    int i;
+
+    mutexInit(&sharedMutex);
+    benchReset(result);
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start = CYCLE_COUNT();
+        mutexLock(&sharedMutex);
+        mutexUnlock(&sharedMutex);
+        benchRecord(result, CYCLE_COUNT() - start);
+    }
+
+    benchReset(&wakeResult);
+    command.op = BENCH_MUTEX;
+    command.replyMB = BENCH_DRIVER_MB;
+    sendMessage(BENCH_WAKE_MB, BENCH_DRIVER_MB, &command, sizeof(BenchCommand));
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        mutexLock(&sharedMutex);
+        /* The wake process runs, blocks on the mutex and lends its priority */
+        eventSet(BENCH_WAKE_PID, BENCH_WAKE_EVENT);
+        wakeStamp = CYCLE_COUNT();
+        mutexUnlock(&sharedMutex);
+    }
+}
+
+/*
+ * @brief   Times an uncontended semWait()/semSignal() pair
+ * @param   [out] BenchResult * result: cycles per pair
+ */
+PRIVATE void benchSemaphore(BenchResult * result)
+{
+    Semaphore semaphore;
+    unsigned long start;
+    int i;
+
+    semInit(&semaphore, 1);
+    benchReset(result);
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start = CYCLE_COUNT();
+        semWait(&semaphore);
+        semSignal(&semaphore);
+        benchRecord(result, CYCLE_COUNT() - start);
+    }
+}
+
+/*
+ * @brief   Times spawning a worker and joining it. The process pool
+ *          must give every PCB and stack back for this to complete;
+ *          a spawn or join that fails is not counted as a sample.
+ * @param   [out] BenchResult * result: cycles per spawn and join
+ *          [in] int priority: priority the workers run at
+ */
+PRIVATE void benchSpawn(BenchResult * result, int priority)
+{
+    unsigned long start;
+    int pid;
+    int i;
+
+    benchReset(result);
+    for(i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        start = CYCLE_COUNT();
+        pid = spawn(benchWorkerProcess, priority, BENCH_WORKER_STACK, (void *)(unsigned long)i);
+        if(pid >= 0 && join(pid) == i)
+        {
+            benchRecord(result, CYCLE_COUNT() - start);
+        }
+    }
+}
+
+/*
+ * @brief   Times jobs fed through the shared job mailbox to a pool of
+ *          spawned workers, which answer each when done
+ * @param   [out] BenchResult * result: cycles per job
+ *          [in] int workers: size of the pool, up to BENCH_MAX_WORKERS
+ */
+PRIVATE void benchWorkers(BenchResult * result, int workers)
+{
+    BenchCommand command;
+    int pids[BENCH_MAX_WORKERS];
+    int fromMB;
+    int round;
+    int i;
+    unsigned long start;
+
+    benchReset(result);
+    for(i = 0; i < workers; i++)
+    {
+        pids[i] = spawn(benchJobWorkerProcess, BENCH_PRIORITY, BENCH_WORKER_STACK, NULL);
+    }
+
+    command.replyMB = BENCH_DRIVER_MB;
+    for(round = 0; round < BENCH_JOB_ROUNDS; round++)
+    {
+        command.op = BENCH_JOB;
+        start = CYCLE_COUNT();
+        for(i = 0; i < BENCH_JOBS; i++)
+        {
+            sendMessage(BENCH_JOBS_MB, BENCH_JOBS_MB, &command, sizeof(BenchCommand));
+        }
+        for(i = 0; i < BENCH_JOBS; i++)
+        {
+            recvMessage(BENCH_DRIVER_MB, &fromMB, &command, sizeof(BenchCommand));
+        }
+        benchRecord(result, (CYCLE_COUNT() - start) / BENCH_JOBS);
+    }
+
+    command.op = BENCH_STOP;
+    for(i = 0; i < workers; i++)
+    {
+        sendMessage(BENCH_JOBS_MB, BENCH_JOBS_MB, &command, sizeof(BenchCommand));
+    }
+    for(i = 0; i < workers; i++)
+    {
+        join(pids[i]);
+    }
+}
+
+/*
+ * @brief   Times how long the interactive process takes to run after
+ *          a message while the hogs are busy at its priority. The driver
+ *          sleeps on a timer after each message so the hogs run.
+ * @param   [in] int mode: scheduler mode of the run, enum schedulermodes
+ */
+PRIVATE void benchSchedLatency(int mode)
+{
+    BenchCommand command;
+    TimerEvent event;
+    int fromMB;
+    int i;
+
+    schedulerMode(mode);
+    benchReset(&schedResult);
+    hogsRun = TRUE;
+    /* The hogs bind their mailboxes when first run, below this priority */
+    timerStart(BENCH_DRIVER_MB, 1, FALSE);
+    recvMessage(BENCH_DRIVER_MB, &fromMB, &event, sizeof(TimerEvent));
+
+    command.op = BENCH_SINK;
+    command.replyMB = BENCH_DRIVER_MB;
+    for(i = 0; i < BENCH_HOGS; i++)
+    {
+        sendMessage(BENCH_HOG_MB + i, BENCH_DRIVER_MB, &command, sizeof(BenchCommand));
+    }
+
+    for(i = 0; i < BENCH_SCHED_SAMPLES; i++)
+    {
+        timerStart(BENCH_DRIVER_MB, BENCH_SCHED_SLEEP, FALSE);
+        command.stamp = CYCLE_COUNT();
+        sendMessage(BENCH_INTERACTIVE_MB, BENCH_DRIVER_MB, &command, sizeof(BenchCommand));
+        recvMessage(BENCH_DRIVER_MB, &fromMB, &event, sizeof(TimerEvent));
+    }
+
+    hogsRun = FALSE;
+    schedulerMode(SCHED_FIXED);
+}
+
+/*
+ * @brief   Reads the probe latencies of an interrupt class, recorded
+ *          while every test before it ran
+ * @param   [out] BenchResult * result: latencies in cycles
+ *          [in] int irqClass: enum irqclasses
+ */
+PRIVATE void benchIrqLatency(BenchResult * result, int irqClass)
+{
+    LatencyHistogram histogram;
+
+    benchReset(result);
+    if(getIrqLatency(irqClass, &histogram) == SUCCESS)
+    {
+        result->samples = histogram.count;
+        result->min = histogram.min;
+        result->max = histogram.max;
+        result->total = histogram.total;
+    }
+}
+
+/*
+ * @brief   Runs every test in turn and reports the results
+ */
+void benchDriverProcess(void)
+{
+    BenchResult roundTrip;
+    BenchResult selfLoop;
+    BenchResult other;
+    int mailBoxList[BENCH_MAX_MAILBOXES];
+    int mailBoxes;
+    int size;
+    int i;
+
+    bind(BENCH_DRIVER_MB);
+    /* Before the bridge binds proxies with any free mailbox */
+    bind(BENCH_JOBS_MB);
+    bind(BENCH_PIPE_WRITER_MB);
+    benchBegin();
+
+    /* First, so two nodes joined by HOST_LINK run it together */
+    benchBridge(&roundTrip, &other);
+    benchReport("bridge", 0, &roundTrip);
+    benchReport("bridge", 1, &other);
+
+    benchSelfLoop(&selfLoop);
+    benchRoundTrip(&roundTrip, &other, selfLoop.min);
+    benchReport("roundtrip", 0, &roundTrip);
+    benchReport("selfloop", 0, &selfLoop);
+    benchReport("switch", 0, &other);
+
+    benchRpc(&other, 1);
+    benchReport("rpc", 1, &other);
+    benchRpc(&other, BENCH_RPC_OUTSTANDING);
+    benchReport("rpc", BENCH_RPC_OUTSTANDING, &other);
+
+    for(size = 1; size <= MESSAGE_SYS_LIMIT; size <<= 1)
+    {
+        benchThroughput(&other, size);
+        benchReport("throughput", size, &other);
+    }
+
+    for(size = MESSAGE_SYS_LIMIT; size <= BENCH_CHANNEL_MAX_WRITE; size <<= 1)
+    {
+        benchChannelStream(&other, size);
+        benchReport("channel", size, &other);
+    }
+
+    mailboxControl(BENCH_JOBS_MB, MB_OPT_SHARED, TRUE);
+    for(i = 1; i <= BENCH_MAX_WORKERS; i <<= 1)
+    {
+        benchWorkers(&other, i);
+        benchReport("workers", i, &other);
+    }
+    unbind(BENCH_JOBS_MB);
+
+    pipeOpen(&benchPipe, BENCH_PIPE_WRITER_MB, BENCH_PIPE_MB);
+    for(size = BENCH_PIPE_WRITE; size <= BENCH_PIPE_MAX_BYTES; size <<= 1)
+    {
+        benchPipeStream(&other, size);
+        benchReport("pipe", size, &other);
+    }
+    unbind(BENCH_PIPE_WRITER_MB);
+
+    mailBoxList[0] = BENCH_DRIVER_MB;
+    for(mailBoxes = 1; mailBoxes <= BENCH_MAX_MAILBOXES; mailBoxes <<= 1)
+    {
+        for(i = 1; i < mailBoxes; i++)
+        {
+            mailBoxList[i] = bind(ANY);
+        }
+        benchReceiveAny(&other, mailBoxList, mailBoxes);
+        benchReport("recvany", mailBoxes, &other);
+        for(i = 1; i < mailBoxes; i++)
+        {
+            unbind(mailBoxList[i]);
+        }
+    }
+
+    benchBind(&roundTrip, &other);
+    benchReport("bind", 0, &roundTrip);
+    benchReport("unbind", 0, &other);
+
+    benchLookup(&other, FALSE);
+    benchReport("lookup", FALSE, &other);
+    benchLookup(&other, TRUE);
+    benchReport("lookup", TRUE, &other);
+
+    for(i = MB_OVERLOAD_DROP_OLDEST; i <= MB_OVERLOAD_LATEST; i++)
+    {
+        benchOverload(&other, i);
+        benchReport("overload", i, &other);
+    }
+
+    benchWake();
+    benchReport("wake", 0, &wakeResult);
+    benchEvent(&other);
+    benchReport("event", 0, &wakeResult);
+    benchReport("event", 1, &other);
+    benchMutex(&other);
+    benchReport("mutex", 0, &other);
+    benchReport("mutex", 1, &wakeResult);
+    benchSemaphore(&other);
+    benchReport("semaphore", 0, &other);
+
+    benchSpawn(&other, BENCH_WAKE_PRIORITY);
+    benchReport("spawn", BENCH_WAKE_PRIORITY, &other);
+    benchSpawn(&other, BENCH_SCHED_PRIORITY);
+    benchReport("spawn", BENCH_SCHED_PRIORITY, &other);
+
+    benchSchedLatency(SCHED_FIXED);
+    benchReport("schedlat", SCHED_FIXED, &schedResult);
+    benchSchedLatency(SCHED_MLFQ);
+    benchReport("schedlat", SCHED_MLFQ, &schedResult);
+
+    benchIrqLatency(&other, IRQ_KERNEL_AWARE);
+    benchReport("irqlat", IRQ_KERNEL_AWARE, &other);
+    benchIrqLatency(&other, IRQ_ZERO_LATENCY);
+    benchReport("irqlat", IRQ_ZERO_LATENCY, &other);
+
+    benchString("BENCH,END\r\n");
+#ifdef HOST_PORT
+    hostExit(0);
+#endif
+}
+
+/*
+ * @brief   Answers RPC requests with their own data, and BENCH_ECHO and
+ *          BENCH_ACK messages to the mailbox they came from, which for
+ *          the bridge test is a proxy of the driver's; discards
+ *          BENCH_SINK messages
+ */
+void benchEchoProcess(void)
+{
+    char contents[MESSAGE_SYS_LIMIT];
+    RpcHeader header;
+    int fromMB;
+    int size;
+
+    bind(BENCH_ECHO_MB);
+    registerName(BENCH_ECHO_NAME, BENCH_ECHO_MB);
+    while(1)
+    {
+        size = recvMessage(BENCH_ECHO_MB, &fromMB, contents, MESSAGE_SYS_LIMIT);
+        if(fromMB == RPC_MB)
+        {
+            memcpy(&header, contents, sizeof(RpcHeader));
+            rpcReply(header.callId, &contents[sizeof(RpcHeader)], size - sizeof(RpcHeader));
+        }
+        else if(contents[0] != BENCH_SINK)
+        {
+            sendMessage(fromMB, BENCH_ECHO_MB, contents, sizeof(BenchCommand));
+        }
+    }
+}
+
+/*
+ * @brief   Records the cycles from each request's stamp to the
+ *          moment this process is running again. A BENCH_EVENTS
+ *          request instead starts BENCH_ITERATIONS waits on its event
+ *          flag, timed from the driver's wakeStamp; BENCH_MUTEX also
+ *          locks the mutex after each, timed from the driver's unlock.
+ */
+void benchWakeProcess(void)
+{
+    BenchCommand command;
+    int fromMB;
+    int i;
+
+    bind(BENCH_WAKE_MB);
+    while(1)
+    {
+        recvMessage(BENCH_WAKE_MB, &fromMB, &command, sizeof(BenchCommand));
+        if(command.op != BENCH_EVENTS && command.op != BENCH_MUTEX)
+        {
+            benchRecord(&wakeResult, CYCLE_COUNT() - command.stamp);
+            continue;
+        }
+        for(i = 0; i < BENCH_ITERATIONS; i++)
+        {
+            eventWait(BENCH_WAKE_EVENT, EVENT_ANY, EVENT_FOREVER);
+            if(command.op == BENCH_MUTEX)
+            {
+                mutexLock(&sharedMutex);
+            }
+            benchRecord(&wakeResult, CYCLE_COUNT() - wakeStamp);
+            if(command.op == BENCH_MUTEX)
+            {
+                mutexUnlock(&sharedMutex);
+            }
+        }
+    }
+}
+
+/*
+ * @brief   Records the cycles from each request's stamp to the
+ *          moment this process, competing with the hogs, runs
+ */
+void benchInteractiveProcess(void)
+{
+    BenchCommand command;
+    int fromMB;
+
+    bind(BENCH_INTERACTIVE_MB);
+    while(1)
+    {
+        recvMessage(BENCH_INTERACTIVE_MB, &fromMB, &command, sizeof(BenchCommand));
+        benchRecord(&schedResult, CYCLE_COUNT() - command.stamp);
+    }
+}
+
+/*
+ * @brief   Drains the benchmark channel, acknowledging every
+ *          BENCH_CHANNEL_BYTES read to the driver
+ */
+void benchReaderProcess(void)
+{
+    unsigned char contents[BENCH_CHANNEL_MAX_WRITE];
+    BenchCommand command;
+    int received = 0;
+
+    bind(BENCH_READER_MB);
+    command.op = BENCH_ACK;
+    while(1)
+    {
+        received += channelRead(&benchChannel, contents, BENCH_CHANNEL_MAX_WRITE);
+        if(received >= BENCH_CHANNEL_BYTES)
+        {
+            received -= BENCH_CHANNEL_BYTES;
+            sendMessage(BENCH_DRIVER_MB, BENCH_READER_MB, &command, sizeof(BenchCommand));
+        }
+    }
+}
+
+/*
+ * @brief   Reads the benchmark pipe in pieces that split its messages,
+ *          acknowledging each end of stream to the driver
+ */
+void benchPipeProcess(void)
+{
+    unsigned char contents[BENCH_PIPE_READ];
+    BenchCommand command;
+    Pipe pipe;
+
+    bind(BENCH_PIPE_MB);
+    pipeOpen(&pipe, BENCH_PIPE_MB, BENCH_PIPE_WRITER_MB);
+    command.op = BENCH_ACK;
+    while(1)
+    {
+        if(!pipeRead(&pipe, contents, BENCH_PIPE_READ))
+        {
+            sendMessage(BENCH_DRIVER_MB, BENCH_PIPE_MB, &command, sizeof(BenchCommand));
+        }
+    }
+}
+
+/*
+ * @brief   Spawned by the spawn test; exits with its argument as the code
+ * @param   [in] void * arg: exit code
+ */
+void benchWorkerProcess(void * arg)
+{
+    exitProcess((int)(unsigned long)arg);
+}
+
+/*
+ * @brief   Spawned by the worker pool test; takes jobs from the shared
+ *          job mailbox, waiting a tick on each before answering, until
+ *          told to stop
+ * @param   [in] void * arg: unused
+ */
+void benchJobWorkerProcess(void * arg)
+{
+    BenchCommand command;
+    TimerEvent event;
+    int replyMB = bind(ANY);
+    int fromMB;
+
+    bind(BENCH_JOBS_MB);
+    recvMessage(BENCH_JOBS_MB, &fromMB, &command, sizeof(BenchCommand));
+    while(command.op == BENCH_JOB)
+    {
+        timerStart(replyMB, 1, FALSE);
+        recvMessage(replyMB, &fromMB, &event, sizeof(TimerEvent));
+        sendMessage(command.replyMB, replyMB, &command, sizeof(BenchCommand));
+        recvMessage(BENCH_JOBS_MB, &fromMB, &command, sizeof(BenchCommand));
+    }
+    unbind(BENCH_JOBS_MB);
+    unbind(replyMB);
+    exitProcess(0);
+}
+
+/*
+ * @brief   Keeps the CPU busy, without blocking, from each message on
+ *          its mailbox until hogsRun is cleared
+ */
+void benchHogProcess(void)
+{
+    BenchCommand command;
+    int mailBox = bind(BENCH_HOG_MB + getid() - BENCH_HOG_PID);
+    int fromMB;
+
+    while(1)
+    {
+        recvMessage(mailBox, &fromMB, &command, sizeof(BenchCommand));
+        while(hogsRun)
+            ;
+    }
+}
+
+/*
+ * @brief   Registers the benchmark processes
+ * @return  int: 0 on success, non-zero if a process could not be registered
+ */
+int registerBenchmarks(void)
+{
+    int registerResult = 0;
+    int i;
+
+    registerResult |= registerProcess(benchWakeProcess, BENCH_WAKE_PID, BENCH_WAKE_PRIORITY);
+    registerResult |= registerProcess(benchEchoProcess, BENCH_ECHO_PID, BENCH_PRIORITY);
+    registerResult |= registerProcess(benchDriverProcess, BENCH_DRIVER_PID, BENCH_PRIORITY);
+    registerResult |= registerProcess(benchInteractiveProcess, BENCH_INTERACTIVE_PID, BENCH_SCHED_PRIORITY);
+    registerResult |= registerProcess(benchReaderProcess, BENCH_READER_PID, BENCH_PRIORITY);
+    registerResult |= registerProcess(benchPipeProcess, BENCH_PIPE_PID, BENCH_PRIORITY);
+    registerResult |= registerProcess(bridgeProcess, BENCH_BRIDGE_PID, BENCH_PRIORITY);
+    channelInit(&benchChannel, channelBuffer, BENCH_CHANNEL_CAPACITY);
+    for(i = 0; i < BENCH_HOGS; i++)
+    {
+        registerResult |= registerProcess(benchHogProcess, BENCH_HOG_PID + i, BENCH_SCHED_PRIORITY);
+    }
+    return registerResult;
+}
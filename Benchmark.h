@@ -0,0 +1,156 @@
+/*
+ * @file    Benchmark.h
+ * @brief   Messaging and scheduling benchmark suite.
+ *          Built in place of the demo processes when KERNEL_BENCHMARK
+ *          is defined (e.g. --define=KERNEL_BENCHMARK, or make -C host
+ *          bench). Results are written to UART0 one per line:
+ *              BENCH,BEGIN,<iterations>
+ *              BENCH,<test>,<parameter>,<samples>,<min>,<mean>,<max>
+ *              BENCH,END
+ *          min/mean/max are DWT cycles per operation.
+ *          schedlat runs once per scheduler mode (parameter is the
+ *          enum schedulermodes value) and takes SysTick ticks per sample.
+ *          channel is cycles per channelWrite() of <parameter> bytes.
+ *          lookup is the cost of finding the echo process' mailbox by
+ *          name: parameter 0 asks the kernel, 1 hits the lookup cache.
+ *          rpc is cycles per call with <parameter> calls outstanding.
+ *          bridge is the echo process reached through the bridge:
+ *          parameter 0 is the round trip, 1 cycles per message of a
+ *          burst. With HOST_LINK naming a link to another node running
+ *          the suite, that node's echo process answers.
+ *          workers is cycles per job with <parameter> workers sharing
+ *          the job mailbox; each job waits a tick, so workers overlap.
+ *          pipe is cycles per transfer of <parameter> bytes, from the
+ *          first pipeWrite() until the reader has read to its end.
+ *          event parameter 0 is the wake latency of eventSet(), to be
+ *          set against wake; 1 is a set and wait that does not block.
+ *          mutex parameter 0 is an uncontended lock and unlock, 1 an
+ *          unlock until the waiter it hands the mutex to runs;
+ *          semaphore is an uncontended wait and signal.
+ *          irqlat parameter is the enum irqclasses value; its samples
+ *          are the probe interrupts taken during the run.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+
+/* Samples taken by each latency test */
+#define BENCH_ITERATIONS    1000
+/* Messages sent back to back per throughput sample */
+#define BENCH_BATCH         16
+/* Throughput samples per message size */
+#define BENCH_BATCHES       64
+/* Largest number of mailboxes used by the receive-any test */
+#define BENCH_MAX_MAILBOXES 8
+
+/* Scheduling latency samples per scheduler mode */
+#define BENCH_SCHED_SAMPLES 32
+/* Ticks the driver sleeps between scheduling latency samples */
+#define BENCH_SCHED_SLEEP   4
+/* CPU-bound processes competing with the interactive one */
+#define BENCH_HOGS          2
+/* Channel test: ring capacity, bytes streamed per sample and the
+ * largest write size (powers of two from MESSAGE_SYS_LIMIT) */
+#define BENCH_CHANNEL_CAPACITY  4096
+#define BENCH_CHANNEL_BYTES     16384
+#define BENCH_CHANNEL_MAX_WRITE 1024
+/* Pipe test: largest transfer (powers of two from 1 KB), transfers
+ * timed per size, bytes per pipeWrite() and per reader pipeRead();
+ * the read size is not a multiple of a message so reads split them */
+#define BENCH_PIPE_MAX_BYTES    65536
+#define BENCH_PIPE_TRANSFERS    8
+#define BENCH_PIPE_WRITE        1024
+#define BENCH_PIPE_READ         48
+/* Most RPC calls outstanding at once */
+#define BENCH_RPC_OUTSTANDING 4
+/* Worker pool test: jobs per sample, samples per pool size and the
+ * largest pool (powers of two from 1) */
+#define BENCH_JOBS          16
+#define BENCH_JOB_ROUNDS    4
+#define BENCH_MAX_WORKERS   4
+/* Queue limit of the overload test's mailbox, and keys sent to it */
+#define BENCH_OVERLOAD_LIMIT 4
+/* Event flag the event test sets on the wake process */
+#define BENCH_WAKE_EVENT    0x1UL
+/* Ticks the bridge test waits for the other node before asking again */
+#define BENCH_BRIDGE_RETRY  50
+/* Stack size of the processes spawned by the spawn test, bytes */
+#define BENCH_WORKER_STACK  256
+
+/* Mailboxes bound by the benchmark processes */
+#define BENCH_DRIVER_MB     1
+#define BENCH_ECHO_MB       2
+#define BENCH_WAKE_MB       3
+#define BENCH_INTERACTIVE_MB 4
+#define BENCH_HOG_MB        5   // first of BENCH_HOGS
+#define BENCH_READER_MB     7
+#define BENCH_PIPE_MB       8   // reading end
+#define BENCH_PIPE_WRITER_MB 9
+#define BENCH_JOBS_MB       10  // shared by the workers
+
+/* Process IDs and priorities */
+#define BENCH_DRIVER_PID    2
+#define BENCH_ECHO_PID      3
+#define BENCH_WAKE_PID      4
+#define BENCH_INTERACTIVE_PID 5
+#define BENCH_HOG_PID       6   // first of BENCH_HOGS
+#define BENCH_READER_PID    8
+#define BENCH_PIPE_PID      9
+#define BENCH_BRIDGE_PID    10
+#define BENCH_PRIORITY      3
+#define BENCH_WAKE_PRIORITY 4
+#define BENCH_SCHED_PRIORITY 2
+
+/* Name the echo process registers its mailbox under */
+#define BENCH_ECHO_NAME     "echo"
+
+/* Requests understood by the echo process (first byte of a message) */
+enum benchops {BENCH_ECHO, BENCH_SINK, BENCH_ACK, BENCH_JOB, BENCH_STOP, BENCH_EVENTS, BENCH_MUTEX};
+
+/*
+ * @brief   Benchmark Command Structure
+ * @details Message sent to the echo and wake processes.
+ *          Only op is present in throughput messages shorter
+ *          than the structure.
+ */
+typedef struct BenchCommand_
+{
+    unsigned char op;
+    unsigned char replyMB;//mailbox the echo process answers to
+    unsigned long stamp;//CYCLE_COUNT() when sent, for the wake test
+}BenchCommand;
+
+/*
+ * @brief   Benchmark Result Structure
+ * @details Running min/max/total of one test in cycles
+ */
+typedef struct BenchResult_
+{
+    unsigned long samples;
+    unsigned long min;
+    unsigned long max;
+    unsigned long total;
+}BenchResult;
+
+#ifndef GLOBAL_BENCHMARK
+#define GLOBAL_BENCHMARK
+
+extern int registerBenchmarks(void);
+
+#else
+
+void benchReset(BenchResult *);
+void benchRecord(BenchResult *, unsigned long);
+void benchReport(char *, int, BenchResult *);
+void benchDriverProcess(void);
+void benchEchoProcess(void);
+void benchWakeProcess(void);
+void benchInteractiveProcess(void);
+void benchWorkerProcess(void *);
+void benchJobWorkerProcess(void *);
+void benchReaderProcess(void);
+void benchPipeProcess(void);
+void benchHogProcess(void);
+
+#endif /* GLOBAL_BENCHMARK */
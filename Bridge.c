@@ -0,0 +1,452 @@
+/*
+ * @file    Bridge.c
+ * @brief   Contains the UART1 link set up and handler, the bridge
+ *          process with its framing and proxy table, and the thread
+ *          mode proxy request
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_BRIDGE
+#include <string.h>
+#include "Bridge.h"
+#include "KernelCall.h"
+#include "Interrupts.h"
+#include "Names.h"
+#include "Rpc.h"
+#include "Utilities.h"
+
+#define CRC_INITIAL     0xFFFF
+#define CRC_POLYNOMIAL  0x1021
+#define BYTE_MASK       0xFF
+#define BYTE_BITS       8
+
+/* Proxies bound so far */
+PRIVATE BridgeProxy proxies[BRIDGE_PROXIES];
+PRIVATE int proxyCount = 0;
+/* Bridge's mailbox, FAILURE until it is bound */
+PRIVATE volatile int linkMB = FAILURE;
+PRIVATE BridgeStats stats;
+
+/* Received bytes; the handler advances rxHead, the bridge rxTail */
+PRIVATE unsigned char rxRing[BRIDGE_RX_RING];
+PRIVATE volatile unsigned long rxHead = 0;
+PRIVATE volatile unsigned long rxTail = 0;
+
+/* Frame being filled, without its CRC, and its messages */
+PRIVATE unsigned char txFrame[BRIDGE_FRAME_LIMIT];
+PRIVATE int txSize = BRIDGE_FRAME_HEADER;
+PRIVATE int txCount = 0;
+PRIVATE unsigned char txSequence = 0;
+
+/* Frame being received, unescaped */
+PRIVATE unsigned char rxFrame[BRIDGE_FRAME_LIMIT];
+PRIVATE int rxSize = 0;
+PRIVATE int rxEscaped = FALSE;
+/* TRUE while skipping an overlong frame to the next flag */
+PRIVATE int rxDiscard = FALSE;
+/* Sequence expected next; rxSynced once a frame has set it */
+PRIVATE unsigned char rxSequence = 0;
+PRIVATE int rxSynced = FALSE;
+
+/*
+ * @brief   Sets up UART1 as the link at 115200 baud, 8N1 with FIFOs,
+ *          interrupting on received data. Called from main() before the
+ *          first process runs.
+ * @param   [in] int loopback: TRUE connects the link to itself, for
+ *          measuring the bridge on one node
+ */
+void bridgeInit(int loopback)
+{
+    volatile int wait;
+
+    SYSCTL_RCGCGPIO_R |= SYSCTL_RCGCGPIO_GPIOB;
+    SYSCTL_RCGCUART_R |= SYSCTL_RCGCUART_UART1;
+    wait = 0; // give time for the clocks to activate
+
+    UART1_CTL_R &= ~UART_CTL_UARTEN;
+    wait = 0;
+
+    UART1_IBRD_R = 8;   // as UART0
+    UART1_FBRD_R = 44;
+    UART1_LCRH_R = UART_LCRH_WLEN_8 | UART_LCRH_FEN;
+
+    GPIO_PORTB_AFSEL_R |= EN_UART_PB0_PB1;
+    GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R & ~BYTE_MASK) | PCTL_UART_PB0_PB1;
+    GPIO_PORTB_DEN_R |= EN_UART_PB0_PB1;
+
+    UART1_IM_R |= UART_INT_RX | UART_INT_RT;
+    UART1_CTL_R = UART_CTL_UARTEN | ((loopback) ? UART_CTL_LBE : 0);
+    wait = 0;
+
+    setInterruptPriority(INT_VEC_UART1, KERNEL_IRQ_LEVEL);
+    InterruptEnable(INT_VEC_UART1);
+    LINK_OPEN(loopback);
+}
+
+/*
+ * @brief   UART1 ISR: moves the received bytes into the ring and wakes
+ *          the bridge to decode them
+ */
+void UART1_IntHandler(void)
+{
+    int data;
+
+    UART1_ICR_R |= UART_INT_RX | UART_INT_RT;
+    while((data = LINK_GETCHAR()) >= 0)
+    {
+        if(rxHead - rxTail < BRIDGE_RX_RING)
+        {
+            rxRing[rxHead & (BRIDGE_RX_RING - 1)] = (unsigned char)data;
+            rxHead++;
+        }
+        else
+        {
+            stats.overruns++;
+        }
+    }
+
+    if(linkMB != FAILURE)
+    {
+        isrPost(linkMB, BRIDGE_LINK_SOURCE);
+    }
+}
+
+/*
+ * @brief   CRC-16/CCITT of a frame
+ * @param   [in] const unsigned char * data: frame bytes
+ *          [in] int size: number of bytes
+ * @return  unsigned int: CRC
+ */
+PRIVATE unsigned int bridgeCrc(const unsigned char * data, int size)
+{
+    unsigned int crc = CRC_INITIAL;
+    int bit;
+
+    while(size--)
+    {
+        crc ^= (unsigned int)*(data++) << BYTE_BITS;
+        for(bit = 0; bit < BYTE_BITS; bit++)
+        {
+            crc = (crc & 0x8000) ? (crc << 1) ^ CRC_POLYNOMIAL : crc << 1;
+        }
+    }
+    return crc & 0xFFFF;
+}
+
+/*
+ * @brief   Finds the proxy of a remote mailbox, binding one if it has none
+ * @param   [in] int remoteMB: mailbox on the other node
+ * @return  int: proxy mailbox; FAILURE if the table is full or no
+ *               mailbox is free
+ */
+PRIVATE int proxyFor(int remoteMB)
+{
+    int i;
+    int MB;
+
+    for(i = 0; i < proxyCount; i++)
+    {
+        if(proxies[i].remoteMB == remoteMB)
+        {
+            return proxies[i].MB;
+        }
+    }
+
+    if(proxyCount == BRIDGE_PROXIES || (MB = bind(ANY)) < 0)
+    {
+        return FAILURE;
+    }
+
+    mailboxControl(MB, MB_OPT_FORWARD, linkMB);
+    proxies[proxyCount].MB = MB;
+    proxies[proxyCount].remoteMB = remoteMB;
+    proxyCount++;
+    return MB;
+}
+
+/*
+ * @brief   Finds the remote mailbox a proxy stands for
+ * @param   [in] int MB: proxy mailbox
+ * @return  int: remote mailbox; FAILURE if MB is not a proxy
+ */
+PRIVATE int proxyRemote(int MB)
+{
+    int i;
+
+    for(i = 0; i < proxyCount; i++)
+    {
+        if(proxies[i].MB == MB)
+        {
+            return proxies[i].remoteMB;
+        }
+    }
+    return FAILURE;
+}
+
+/*
+ * @brief   Writes one frame byte to the link, escaped if need be
+ * @param   [in] unsigned char data: byte of the frame
+ */
+PRIVATE void linkWrite(unsigned char data)
+{
+    if(data == BRIDGE_FLAG || data == BRIDGE_ESCAPE)
+    {
+        LINK_PUTCHAR(BRIDGE_ESCAPE);
+        data ^= BRIDGE_ESCAPE_XOR;
+    }
+    LINK_PUTCHAR(data);
+}
+
+/*
+ * @brief   Sends the open frame, if it holds any message, and opens the
+ *          next
+ */
+PRIVATE void bridgeFlush(void)
+{
+    unsigned int crc;
+    int i;
+
+    if(!txCount)
+    {
+        return;
+    }
+
+    txFrame[0] = txSequence++;
+    txFrame[1] = (unsigned char)txCount;
+    crc = bridgeCrc(txFrame, txSize);
+    txFrame[txSize++] = crc & BYTE_MASK;
+    txFrame[txSize++] = crc >> BYTE_BITS;
+
+    LINK_PUTCHAR(BRIDGE_FLAG);
+    for(i = 0; i < txSize; i++)
+    {
+        linkWrite(txFrame[i]);
+    }
+    LINK_PUTCHAR(BRIDGE_FLAG);
+
+    stats.framesSent++;
+    txSize = BRIDGE_FRAME_HEADER;
+    txCount = 0;
+}
+
+/*
+ * @brief   Adds a message sent to a proxy to the open frame, sending
+ *          the frame first if it is full
+ * @param   [in] int MB: proxy it was sent to
+ *          [in] int fromMB: mailbox of its sender
+ *          [in] const char * contents: message data
+ *          [in] int size: bytes of contents
+ */
+PRIVATE void bridgeQueue(int MB, int fromMB, const char * contents, int size)
+{
+    int remoteMB = proxyRemote(MB);
+
+    //a kernel sender (e.g. a timer) could not be answered across the link
+    if(remoteMB == FAILURE || fromMB < 0)
+    {
+        stats.dropped++;
+        return;
+    }
+
+    if(txCount == BRIDGE_BATCH)
+    {
+        bridgeFlush();
+    }
+
+    txFrame[txSize++] = remoteMB & BYTE_MASK;
+    txFrame[txSize++] = (remoteMB >> BYTE_BITS) & BYTE_MASK;
+    txFrame[txSize++] = fromMB & BYTE_MASK;
+    txFrame[txSize++] = (fromMB >> BYTE_BITS) & BYTE_MASK;
+    txFrame[txSize++] = (unsigned char)size;
+    memcpy(&txFrame[txSize], contents, size);
+    txSize += size;
+    txCount++;
+    stats.messagesSent++;
+}
+
+/*
+ * @brief   Delivers the messages of a received frame that passed its CRC
+ */
+PRIVATE void bridgeDeliver(void)
+{
+    int end = rxSize - BRIDGE_CRC_BYTES;
+    int offset = BRIDGE_FRAME_HEADER;
+    int count = rxFrame[1];
+    int toMB;
+    int fromMB;
+    int size;
+    int returnMB;
+
+    if(rxSynced)
+    {
+        stats.lostFrames += (unsigned char)(rxFrame[0] - rxSequence);
+    }
+    rxSequence = rxFrame[0] + 1;
+    rxSynced = TRUE;
+    stats.framesReceived++;
+
+    while(count--)
+    {
+        if(offset + BRIDGE_RECORD_HEADER > end ||
+           offset + BRIDGE_RECORD_HEADER + rxFrame[offset + 4] > end)
+        {
+            stats.badFrames++;
+            return;
+        }
+
+        toMB = (short)(rxFrame[offset] | (rxFrame[offset + 1] << BYTE_BITS));
+        fromMB = (short)(rxFrame[offset + 2] | (rxFrame[offset + 3] << BYTE_BITS));
+        size = rxFrame[offset + 4];
+        offset += BRIDGE_RECORD_HEADER;
+
+        //replies to the receiver go back through a proxy of the sender
+        returnMB = proxyFor(fromMB);
+        if(returnMB < 0 || sendMessage(toMB, returnMB, &rxFrame[offset], size) < 0)
+        {
+            stats.dropped++;
+        }
+        else
+        {
+            stats.messagesReceived++;
+        }
+        offset += size;
+    }
+}
+
+/*
+ * @brief   Decodes the bytes the handler has received, delivering each
+ *          complete frame
+ */
+PRIVATE void bridgeReceive(void)
+{
+    unsigned char data;
+    unsigned int crc;
+
+    while(rxTail != rxHead)
+    {
+        data = rxRing[rxTail & (BRIDGE_RX_RING - 1)];
+        rxTail++;
+
+        if(data == BRIDGE_FLAG)
+        {
+            //back to back flags delimit nothing
+            if(rxSize && !rxDiscard)
+            {
+                crc = rxFrame[rxSize - 2] | (rxFrame[rxSize - 1] << BYTE_BITS);
+                if(rxSize >= BRIDGE_FRAME_HEADER + BRIDGE_CRC_BYTES &&
+                   bridgeCrc(rxFrame, rxSize - BRIDGE_CRC_BYTES) == crc)
+                {
+                    bridgeDeliver();
+                }
+                else
+                {
+                    stats.badFrames++;
+                }
+            }
+            rxSize = 0;
+            rxEscaped = FALSE;
+            rxDiscard = FALSE;
+        }
+        else if(rxDiscard)
+        {
+            continue;
+        }
+        else if(data == BRIDGE_ESCAPE)
+        {
+            rxEscaped = TRUE;
+        }
+        else if(rxSize == BRIDGE_FRAME_LIMIT)
+        {
+            stats.badFrames++;
+            rxDiscard = TRUE;
+        }
+        else
+        {
+            rxFrame[rxSize++] = (rxEscaped) ? data ^ BRIDGE_ESCAPE_XOR : data;
+            rxEscaped = FALSE;
+        }
+    }
+}
+
+/*
+ * @brief   The bridge: binds and names its mailbox, then serves it
+ *          forever. Messages forwarded from proxies are batched into
+ *          the open frame, sent once none is waiting; requests for a
+ *          proxy are answered with its mailbox; wakeups from the
+ *          handler decode the received bytes.
+ */
+void bridgeProcess(void)
+{
+    char message[MESSAGE_SYS_LIMIT];
+    MailBoxStats mailbox;
+    ForwardHeader header;
+    RpcHeader request;
+    int remoteMB;
+    int proxyMB;
+    int fromMB;
+    int size;
+
+    linkMB = bind(ANY);
+    registerName(BRIDGE_NAME, linkMB);
+    //bytes may have arrived before the bridge ran
+    bridgeReceive();
+
+    while(1)
+    {
+        size = recvMessage(linkMB, &fromMB, message, MESSAGE_SYS_LIMIT);
+
+        if(fromMB == BRIDGE_LINK_SOURCE)
+        {
+            bridgeReceive();
+        }
+        else if(fromMB == RPC_MB && size == (int)(sizeof(RpcHeader) + sizeof(int)))
+        {
+            memcpy(&request, message, sizeof(RpcHeader));
+            memcpy(&remoteMB, &message[sizeof(RpcHeader)], sizeof(int));
+            proxyMB = proxyFor(remoteMB);
+            rpcReply(request.callId, &proxyMB, sizeof(int));
+        }
+        else if(size >= (int)sizeof(ForwardHeader))
+        {
+            memcpy(&header, message, sizeof(ForwardHeader));
+            bridgeQueue(header.toMB, fromMB, &message[sizeof(ForwardHeader)],
+                        size - sizeof(ForwardHeader));
+        }
+
+        //a frame goes out once the burst filling it has been taken
+        getMailBoxStats(linkMB, &mailbox);
+        if(!mailbox.depth)
+        {
+            bridgeFlush();
+        }
+    }
+}
+
+/*
+ * @brief   Asks the bridge for the proxy of a remote mailbox
+ * @param   [in] int remoteMB: mailbox on the other node
+ * @return  int: local proxy mailbox to send to; FAILURE if the bridge is
+ *               not running or has no proxy left
+ */
+int bridgeProxy(int remoteMB)
+{
+    int bridgeMB = lookupName(BRIDGE_NAME);
+    int proxyMB;
+
+    if(bridgeMB < 0 ||
+       rpcCall(bridgeMB, &remoteMB, sizeof(int), &proxyMB, sizeof(int)) != sizeof(int))
+    {
+        return FAILURE;
+    }
+    return proxyMB;
+}
+
+/*
+ * @brief   Copies the link counters
+ * @param   [out] BridgeStats * copy: destination
+ */
+void bridgeStats(BridgeStats * copy)
+{
+    *copy = stats;
+}
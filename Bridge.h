@@ -0,0 +1,126 @@
+/*
+ * @file    Bridge.h
+ * @brief   Mailbox bridging to another node over a serial link.
+ *          The bridge process stands in locally for mailboxes of the
+ *          node at the other end of UART1: bridgeProxy() returns a proxy
+ *          mailbox it binds for a remote mailbox number, and a message
+ *          sent to the proxy is delivered to the remote mailbox. Proxies
+ *          forward (MB_OPT_FORWARD) to the bridge's own mailbox, named
+ *          BRIDGE_NAME, so it learns which proxy each message was for.
+ *          A message arriving from the link is sent from a proxy of its
+ *          remote sender, bound on first use, so the receiver's reply
+ *          goes back the same way.
+ *          On the link, messages are batched into frames: the bridge
+ *          adds each message to the open frame and sends it when no more
+ *          are waiting or BRIDGE_BATCH are in it, so a burst costs few
+ *          frames. A frame is
+ *              FLAG sequence count { to from size data }... CRC-16 FLAG
+ *          with mailboxes as 16-bit little-endian numbers, and FLAG and
+ *          ESCAPE bytes inside it escaped HDLC style. A frame failing its
+ *          CRC is discarded; sequence gaps count the frames lost.
+ *          Received bytes are kept in a ring by the UART1 handler, which
+ *          wakes the bridge with isrPost().
+ *          Hosted builds use the file or descriptor in $HOST_LINK as the
+ *          link, e.g. a pty, so two instances can be joined.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "UART.h"
+#include "Messages.h"
+
+/* UART1 registers, on PB0 (receive) and PB1 (transmit) */
+#define GPIO_PORTB_AFSEL_R  HW_REGISTER(0x40059420)   // GPIOB Alternate Function Select Register
+#define GPIO_PORTB_DEN_R    HW_REGISTER(0x4005951C)   // GPIOB Digital Enable Register
+#define GPIO_PORTB_PCTL_R   HW_REGISTER(0x4005952C)   // GPIOB Port Control Register
+#define UART1_DR_R          HW_REGISTER(0x4000D000)   // UART1 Data Register
+#define UART1_FR_R          HW_REGISTER(0x4000D018)   // UART1 Flag Register
+#define UART1_IBRD_R        HW_REGISTER(0x4000D024)   // UART1 Integer Baud-Rate Divisor Register
+#define UART1_FBRD_R        HW_REGISTER(0x4000D028)   // UART1 Fractional Baud-Rate Divisor Register
+#define UART1_LCRH_R        HW_REGISTER(0x4000D02C)   // UART1 Line Control Register
+#define UART1_CTL_R         HW_REGISTER(0x4000D030)   // UART1 Control Register
+#define UART1_IM_R          HW_REGISTER(0x4000D038)   // UART1 Interrupt Mask Register
+#define UART1_ICR_R         HW_REGISTER(0x4000D044)   // UART1 Interrupt Clear Register
+
+#define INT_VEC_UART1           6           // UART1 Rx and Tx interrupt index (decimal)
+#define SYSCTL_RCGCUART_UART1   0x00000002  // UART1 Clock Gating Control
+#define SYSCTL_RCGCGPIO_GPIOB   0x00000002  // Port B Clock Gating Control
+#define UART_CTL_LBE            0x00000080  // UART Loop Back Enable
+#define EN_UART_PB0_PB1         0x00000003  // PB1-0 UART function and digital I/O
+#define PCTL_UART_PB0_PB1       0x00000011  // PB1-0 port control: U1RX, U1TX
+
+/* Link byte access; Hardware.h may substitute its own */
+#ifndef LINK_PUTCHAR
+#define LINK_PUTCHAR(data)      do { while(UART1_FR_R & UART_FR_TXFF); UART1_DR_R = (data); } while(0)
+#endif
+#ifndef LINK_GETCHAR
+#define LINK_GETCHAR()          ((UART1_FR_R & UART_FR_RXFE) ? -1 : (int)(UART1_DR_R & 0xFF))
+#endif
+#ifndef LINK_OPEN
+#define LINK_OPEN(loopback)     do {} while(0)
+#endif
+
+/* Name of the bridge's mailbox */
+#define BRIDGE_NAME         "bridge"
+/* Sender reported with the UART1 handler's wakeups */
+#define BRIDGE_LINK_SOURCE  -3
+/* Proxy mailboxes bound at once, requested and for remote senders */
+#define BRIDGE_PROXIES      16
+/* Largest message sent through a proxy */
+#define BRIDGE_LIMIT        FORWARD_LIMIT
+/* Most messages in one frame */
+#define BRIDGE_BATCH        8
+
+/* Frame bytes before escaping */
+#define BRIDGE_FLAG         0x7E
+#define BRIDGE_ESCAPE       0x7D
+#define BRIDGE_ESCAPE_XOR   0x20
+#define BRIDGE_FRAME_HEADER 2   // sequence, count
+#define BRIDGE_RECORD_HEADER 5  // to, from, size
+#define BRIDGE_CRC_BYTES    2
+#define BRIDGE_FRAME_LIMIT  (BRIDGE_FRAME_HEADER + BRIDGE_CRC_BYTES + \
+                             BRIDGE_BATCH * (BRIDGE_RECORD_HEADER + BRIDGE_LIMIT))
+/* Received bytes held for the bridge, a power of two */
+#define BRIDGE_RX_RING      1024
+
+/*
+ * @brief   Bridge Proxy Structure
+ * @details A local mailbox standing in for a remote one
+ */
+typedef struct BridgeProxy_
+{
+    int MB;//proxy mailbox, bound by the bridge
+    int remoteMB;//mailbox on the other node
+}BridgeProxy;
+
+/*
+ * @brief   Bridge Statistics Structure
+ * @details Link counters, returned by bridgeStats()
+ */
+typedef struct BridgeStats_
+{
+    unsigned long framesSent;
+    unsigned long framesReceived;
+    unsigned long messagesSent;
+    unsigned long messagesReceived;
+    /* Frames failing their CRC or malformed */
+    unsigned long badFrames;
+    /* Frames missing from the received sequence */
+    unsigned long lostFrames;
+    /* Messages without a proxy, or that could not be delivered */
+    unsigned long dropped;
+    /* Bytes lost to a full receive ring */
+    unsigned long overruns;
+}BridgeStats;
+
+#ifndef GLOBAL_BRIDGE
+#define GLOBAL_BRIDGE
+
+extern void bridgeInit(int);
+extern void bridgeProcess(void);
+extern int bridgeProxy(int);
+extern void bridgeStats(BridgeStats *);
+extern void UART1_IntHandler(void);
+
+#endif /* GLOBAL_BRIDGE */
@@ -0,0 +1,256 @@
+/*
+ * @file    Budget.c
+ * @brief   Contains CPU budget charging, exhaustion and sporadic
+ *          server replenishment
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_BUDGET
+#include "Budget.h"
+#include "EDF.h"
+#include "SVC.h"
+#include "Utilities.h"
+
+PRIVATE Budget budgets[BUDGET_AMOUNT];
+PRIVATE int budgetsUsed = 0;
+
+/*
+ * @brief   Creates a budget. Called from main() before the kernel starts.
+ * @param   [in] unsigned long capacity: ticks of CPU per period
+ *          [in] unsigned long period: replenishment period in ticks
+ *          [in] int policy: enum budgetpolicies
+ * @return  int: budget ID; -1 -> invalid arguments or no budget is free
+ */
+int createBudget(unsigned long capacity, unsigned long period, int policy)
+{
+    Budget * budget;
+
+    if(!capacity || capacity > period || (policy != BUDGET_DEMOTE && policy != BUDGET_HOLD) ||
+       budgetsUsed >= BUDGET_AMOUNT)
+    {
+        return FAILURE;
+    }
+
+    budget = &budgets[budgetsUsed];
+    budget->capacity = budget->left = capacity;
+    budget->period = period;
+    budget->policy = policy;
+    budget->exhausted = FALSE;
+    budget->exhaustions = 0;
+    budget->charging = FALSE;
+    budget->pending = 0;
+    budget->members = NULL;
+    return budgetsUsed++;
+}
+
+/*
+ * @brief   Makes a registered process draw on a budget. Processes
+ *          assigned the same budget share it as a group.
+ * @param   [in] unsigned int pid: Process ID of the process
+ *          [in] int id: budget ID from createBudget()
+ * @return  int: 1 -> success; -1 -> unknown process or budget, or the
+ *               process already has a budget
+ */
+int assignBudget(unsigned int pid, int id)
+{
+    PCB * process = findProcess(pid);
+
+    if(!process || process->budget || id < 0 || id >= budgetsUsed)
+    {
+        return FAILURE;
+    }
+
+    process->budget = &budgets[id];
+    process->nextMember = budgets[id].members;
+    budgets[id].members = process;
+    return SUCCESS;
+}
+
+/*
+ * @brief   Ends the stretch of running being charged, scheduling the
+ *          ticks it used to be returned one period after it began
+ * @param   [in/out] Budget * budget: budget charged
+ */
+PRIVATE void budgetClose(Budget * budget)
+{
+    Replenishment * last;
+
+    if(budget->charging && budget->charged)
+    {
+        if(budget->pending < BUDGET_REPLENISHMENTS)
+        {
+            last = &budget->replenishments[budget->pending++];
+            last->amount = 0;
+        }
+        else
+        {
+            /* Merging into the last one only ever delays ticks */
+            last = &budget->replenishments[BUDGET_REPLENISHMENTS - 1];
+        }
+        last->at = budget->chargeStart + budget->period;
+        last->amount += budget->charged;
+    }
+    budget->charging = FALSE;
+}
+
+/*
+ * @brief   Gives ticks back to a budget. If it was exhausted, held
+ *          processes are queued again and demoted ones restored.
+ * @param   [in/out] Budget * budget: budget replenished
+ *          [in] unsigned long amount: ticks returned
+ */
+PRIVATE void budgetReplenish(Budget * budget, unsigned long amount)
+{
+    PCB * member;
+
+    budget->left += amount;
+    budget->left = (budget->left > budget->capacity) ? budget->capacity : budget->left;
+
+    if(budget->exhausted && budget->left)
+    {
+        budget->exhausted = FALSE;
+        for(member = budget->members; member; member = member->nextMember)
+        {
+            if(member->held)
+            {
+                member->held = FALSE;
+                addPCB(member, member->priority);
+            }
+            else
+            {
+                restorePriority(member);
+            }
+        }
+    }
+}
+
+/*
+ * @brief   Applies the budget's policy to its ready processes; the
+ *          others meet it in addPCB() when they are next woken
+ * @param   [in/out] Budget * budget: budget that ran out
+ */
+PRIVATE void budgetExhaust(Budget * budget)
+{
+    PCB * member;
+
+    budget->exhausted = TRUE;
+    budget->exhaustions++;
+    for(member = budget->members; member; member = member->nextMember)
+    {
+        if(!IS_BLOCKED(member))
+        {
+            unlinkPCB(member);
+            addPCB(member, member->priority);
+        }
+    }
+}
+
+/*
+ * @brief   Called from pendSV on every SysTick: returns replenishments
+ *          that are due, then charges the tick to the budget of the
+ *          process SysTick interrupted
+ * @param   [in] PCB * interrupted: process that was running
+ *          [in] unsigned long now: current tick
+ */
+void budgetTick(PCB * interrupted, unsigned long now)
+{
+    Budget * budget;
+    int i;
+
+    for(budget = budgets; budget < &budgets[budgetsUsed]; budget++)
+    {
+        while(budget->pending && !DEADLINE_BEFORE(now, budget->replenishments[0].at))
+        {
+            unsigned long amount = budget->replenishments[0].amount;
+
+            budget->pending--;
+            for(i = 0; i < budget->pending; i++)
+            {
+                budget->replenishments[i] = budget->replenishments[i + 1];
+            }
+            budgetReplenish(budget, amount);
+        }
+    }
+
+    budget = interrupted->budget;
+    /* A demoted process runs in the background free of charge */
+    if(!budget || budget->exhausted)
+    {
+        return;
+    }
+
+    if(!budget->charging)
+    {
+        budget->charging = TRUE;
+        budget->chargeStart = now;
+        budget->charged = 0;
+    }
+    budget->charged++;
+    if(!--budget->left)
+    {
+        budgetClose(budget);
+        budgetExhaust(budget);
+    }
+}
+
+/*
+ * @brief   Called on every context switch: a budget stops being
+ *          charged when none of its processes is on the CPU
+ * @param   [in] PCB * from: process leaving the CPU, NULL if it terminated
+ *          [in] PCB * to: process being switched in
+ */
+void budgetSwitch(PCB * from, PCB * to)
+{
+    if(from && from->budget && from->budget != to->budget)
+    {
+        budgetClose(from->budget);
+    }
+}
+
+/*
+ * @brief   Removes a terminating process from its budget's group
+ * @param   [in/out] PCB * process: process terminating
+ */
+void budgetDetach(PCB * process)
+{
+    PCB ** link;
+
+    if(!process->budget)
+    {
+        return;
+    }
+
+    budgetClose(process->budget);
+    for(link = &process->budget->members; *link; link = &((*link)->nextMember))
+    {
+        if(*link == process)
+        {
+            *link = process->nextMember;
+            break;
+        }
+    }
+    process->budget = NULL;
+}
+
+/*
+ * @brief   Called by addPCB(): the level a process becoming ready is
+ *          queued at once its budget's policy is applied
+ * @param   [in/out] PCB * process: process becoming ready
+ *          [in] int newPriority: level it would be queued at
+ * @return  int: level to queue it at; -1 -> held, do not queue it
+ */
+int budgetQueue(PCB * process, int newPriority)
+{
+    if(!process->budget || !process->budget->exhausted)
+    {
+        return newPriority;
+    }
+
+    if(process->budget->policy == BUDGET_HOLD)
+    {
+        process->held = TRUE;
+        return -1;
+    }
+    return BACKGROUND_PRIORITY;
+}
@@ -0,0 +1,73 @@
+/*
+ * @file    Budget.h
+ * @brief   Sporadic-server CPU budgets.
+ *          A budget allows a process, or a group of processes sharing
+ *          it, budget SysTick ticks of CPU per replenishment period.
+ *          The process running when SysTick fires is charged the tick.
+ *          Ticks used in one stretch of running are given back one
+ *          period after the stretch began (sporadic server rule).
+ *          When the budget runs out its processes are, by policy:
+ *              BUDGET_DEMOTE   queued at BACKGROUND_PRIORITY
+ *              BUDGET_HOLD     kept off the CPU
+ *          until the next replenishment. Budgets are created and
+ *          assigned from main() before the kernel starts.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Process.h"
+
+/* Budgets available */
+#define BUDGET_AMOUNT           8
+/* Pending replenishments kept per budget; later ones merge into the last */
+#define BUDGET_REPLENISHMENTS   4
+/* Priority an exhausted BUDGET_DEMOTE process runs at */
+#define BACKGROUND_PRIORITY     0
+
+enum budgetpolicies {BUDGET_DEMOTE, BUDGET_HOLD};
+
+/*
+ * @brief   Replenishment Structure
+ * @details Ticks returned to a budget at a given tick
+ */
+typedef struct Replenishment_
+{
+    unsigned long at;
+    unsigned long amount;
+}Replenishment;
+
+/*
+ * @brief   Budget Structure
+ * @details CPU budget shared by the processes linked through
+ *          their nextMember
+ */
+typedef struct Budget_
+{
+    unsigned long capacity;//ticks per period
+    unsigned long period;//replenishment period in ticks
+    unsigned long left;//ticks available now
+    int policy;//enum budgetpolicies
+    int exhausted;//TRUE from running out to the next replenishment
+    unsigned long exhaustions;//times the budget ran out
+    /* Stretch of running being charged */
+    int charging;
+    unsigned long chargeStart;
+    unsigned long charged;
+    /* Pending replenishments, oldest first */
+    Replenishment replenishments[BUDGET_REPLENISHMENTS];
+    int pending;
+    PCB * members;
+}Budget;
+
+#ifndef GLOBAL_BUDGET
+#define GLOBAL_BUDGET
+
+extern int createBudget(unsigned long, unsigned long, int);
+extern int assignBudget(unsigned int, int);
+extern void budgetTick(PCB *, unsigned long);
+extern void budgetSwitch(PCB *, PCB *);
+extern void budgetDetach(PCB *);
+extern int budgetQueue(PCB *, int);
+
+#endif /* GLOBAL_BUDGET */
@@ -0,0 +1,186 @@
+/*
+ * @file    Channel.c
+ * @brief   Contains the thread mode channel reads and writes and the
+ *          kernel side of blocking and waking their processes
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_CHANNEL
+#include <string.h>
+#include "Channel.h"
+#include "KernelCall.h"
+#include "SVC.h"
+#include "DWT.h"
+#include "Utilities.h"
+
+/*
+ * @brief   Prepares an empty channel over a caller supplied buffer.
+ *          Called before either side uses the channel.
+ * @param   [out] Channel * channel: channel to initialize
+ *          [in] void * buffer: ring storage of capacity bytes
+ *          [in] unsigned long capacity: a power of two
+ * @return  int: SUCCESS; FAILURE if capacity is not a power of two
+ */
+int channelInit(Channel * channel, void * buffer, unsigned long capacity)
+{
+    if(!capacity || (capacity & (capacity - 1)))
+    {
+        return FAILURE;
+    }
+
+    channel->head = channel->tail = 0;
+    channel->mask = capacity - 1;
+    channel->buffer = (unsigned char *)buffer;
+    channel->waiting[CHANNEL_READER] = channel->waiting[CHANNEL_WRITER] = FALSE;
+    channel->blocked[CHANNEL_READER] = channel->blocked[CHANNEL_WRITER] = NULL;
+    return SUCCESS;
+}
+
+/*
+ * @brief   Writes every byte of data, blocking while the ring is full
+ * @param   [in/out] Channel * channel: channel written
+ *          [in] const void * data: bytes to write
+ *          [in] int size: number of bytes
+ * @return  int: size
+ */
+int channelWrite(Channel * channel, const void * data, int size)
+{
+    const unsigned char * source = (const unsigned char *)data;
+    unsigned long capacity = channel->mask + 1;
+    unsigned long space;
+    unsigned long offset;
+    unsigned long chunk;
+    unsigned long first;
+    int written = 0;
+
+    while(written < size)
+    {
+        space = capacity - (channel->head - channel->tail);
+        if(!space)
+        {
+            channel->waiting[CHANNEL_WRITER] = TRUE;
+            channelBlock(channel, CHANNEL_WRITER);
+            continue;
+        }
+
+        chunk = (space < (unsigned long)(size - written)) ? space : (unsigned long)(size - written);
+        offset = channel->head & channel->mask;
+        first = (chunk < capacity - offset) ? chunk : capacity - offset;
+        memcpy(&channel->buffer[offset], source + written, first);
+        memcpy(channel->buffer, source + written + first, chunk - first);
+        /* Publish the bytes only once they are in the ring; memcpy()
+         * may be inlined, so order it before the volatile head */
+        DMB();
+        channel->head += chunk;
+        written += chunk;
+
+        if(channel->waiting[CHANNEL_READER])
+        {
+            channelWake(channel, CHANNEL_READER);
+        }
+    }
+    return written;
+}
+
+/*
+ * @brief   Reads up to size bytes, blocking while the ring is empty
+ * @param   [in/out] Channel * channel: channel read
+ *          [out] void * data: receives the bytes
+ *          [in] int size: most bytes wanted
+ * @return  int: number of bytes read, at least 1 if size is
+ */
+int channelRead(Channel * channel, void * data, int size)
+{
+    unsigned char * destination = (unsigned char *)data;
+    unsigned long capacity = channel->mask + 1;
+    unsigned long filled;
+    unsigned long offset;
+    unsigned long chunk;
+    unsigned long first;
+
+    if(size <= 0)
+    {
+        return 0;
+    }
+
+    while(!(filled = channel->head - channel->tail))
+    {
+        channel->waiting[CHANNEL_READER] = TRUE;
+        channelBlock(channel, CHANNEL_READER);
+    }
+
+    /* Read no byte of the ring before the head that published it */
+    DMB();
+    chunk = (filled < (unsigned long)size) ? filled : (unsigned long)size;
+    offset = channel->tail & channel->mask;
+    first = (chunk < capacity - offset) ? chunk : capacity - offset;
+    memcpy(destination, &channel->buffer[offset], first);
+    memcpy(destination + first, channel->buffer, chunk - first);
+    /* Release the space only once the bytes are copied out */
+    DMB();
+    channel->tail += chunk;
+
+    if(channel->waiting[CHANNEL_WRITER])
+    {
+        channelWake(channel, CHANNEL_WRITER);
+    }
+    return chunk;
+}
+
+/*
+ * @brief   Blocks the caller on its side of a channel unless the other
+ *          side has made progress since the caller looked
+ * @param   [in/out] PCB * caller: reader or writer of the channel
+ *          [in/out] Channel * channel: channel it cannot progress on
+ *          [in] int side: CHANNEL_READER or CHANNEL_WRITER
+ * @return  int: TRUE if the caller blocked; FAILURE if side is invalid
+ */
+int kernelChannelBlock(PCB * caller, Channel * channel, int side)
+{
+    unsigned long filled = channel->head - channel->tail;
+
+    if(side != CHANNEL_READER && side != CHANNEL_WRITER)
+    {
+        return FAILURE;
+    }
+
+    if((side == CHANNEL_READER) ? (filled != 0) : (filled <= channel->mask))
+    {
+        channel->waiting[side] = FALSE;
+        return FALSE;
+    }
+
+    removePCB();
+    caller->waitingChannel = channel;
+    caller->blockedAt = CYCLE_COUNT();
+    channel->blocked[side] = caller;
+    return TRUE;
+}
+
+/*
+ * @brief   Clears a side's waiting flag and wakes it if it blocked
+ * @param   [in/out] Channel * channel: channel that progressed
+ *          [in] int side: side to wake
+ * @return  int: SUCCESS; FAILURE if side is invalid
+ */
+int kernelChannelWake(Channel * channel, int side)
+{
+    PCB * blocked;
+
+    if(side != CHANNEL_READER && side != CHANNEL_WRITER)
+    {
+        return FAILURE;
+    }
+
+    channel->waiting[side] = FALSE;
+    blocked = channel->blocked[side];
+    if(blocked)
+    {
+        channel->blocked[side] = NULL;
+        blocked->waitingChannel = NULL;
+        blocked->blockedCycles += CYCLE_COUNT() - blocked->blockedAt;
+        addPCB(blocked, blocked->priority);
+    }
+    return SUCCESS;
+}
@@ -0,0 +1,51 @@
+/*
+ * @file    Channel.h
+ * @brief   Single-producer/single-consumer byte ring channels.
+ *          A Channel and its buffer live in memory both processes can
+ *          reach. channelWrite() and channelRead() copy straight into
+ *          and out of the ring in thread mode, each side advancing only
+ *          its own counter, so no lock or kernel call is needed while
+ *          the ring is neither empty nor full. The kernel is entered
+ *          only to block a side that cannot progress and to wake it:
+ *              - a side about to block sets its waiting flag, then
+ *                calls channelBlock(); the kernel blocks it only if the
+ *                ring is still empty (reader) or full (writer)
+ *              - after moving data a side that sees the other's flag
+ *                calls channelWake(), which clears the flag and makes
+ *                the other side ready if it blocked
+ *          The capacity must be a power of two. One process writes and
+ *          one process reads each channel.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Process.h"
+
+enum channelsides {CHANNEL_READER, CHANNEL_WRITER, CHANNEL_SIDES};
+
+/*
+ * @brief   Channel Structure
+ * @details head and tail count the bytes written and read since
+ *          channelInit(); their difference is the fill level
+ */
+typedef struct Channel_
+{
+    volatile unsigned long head;//written only by the writer
+    volatile unsigned long tail;//written only by the reader
+    unsigned long mask;//capacity - 1
+    unsigned char * buffer;
+    volatile unsigned char waiting[CHANNEL_SIDES];//side is about to block or has
+    PCB * blocked[CHANNEL_SIDES];//kernel: side blocked in channelBlock()
+}Channel;
+
+#ifndef GLOBAL_CHANNEL
+#define GLOBAL_CHANNEL
+
+extern int channelInit(Channel *, void *, unsigned long);
+extern int channelWrite(Channel *, const void *, int);
+extern int channelRead(Channel *, void *, int);
+extern int kernelChannelBlock(PCB *, Channel *, int);
+extern int kernelChannelWake(Channel *, int);
+
+#endif /* GLOBAL_CHANNEL */
@@ -0,0 +1,168 @@
+/*
+ * @file    Console.c
+ * @brief   Contains the console mode and the COBS record encoder
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_CONSOLE
+#include "Console.h"
+#include "UART.h"
+#include "DWT.h"
+#include "Process.h"
+
+#define BYTE_MASK       0xFF
+#define BYTE_BITS       8
+#define TIMESTAMP_BYTES 4
+#define NUMBER_MORE     (1 << CONSOLE_NUMBER_BITS)
+
+PRIVATE int consoleMode = CONSOLE_DEFAULT_MODE;
+
+/* Bytes of the record since the last code byte was written */
+PRIVATE unsigned char block[CONSOLE_BLOCK];
+PRIVATE int blockSize = 0;
+PRIVATE int recordOpen = FALSE;
+PRIVATE int recordType;
+
+/*
+ * @brief   Writes the code byte and the bytes it covers
+ * @param   [in] int code: blockSize + 1
+ */
+PRIVATE void blockWrite(int code)
+{
+    int i;
+
+    UART_PUTCHAR((char)code);
+    for(i = 0; i < blockSize; i++)
+    {
+        UART_PUTCHAR((char)block[i]);
+    }
+    blockSize = 0;
+}
+
+/*
+ * @brief   Adds bytes to the open record. Each zero byte ends a block,
+ *          written after a code byte giving its length; a block of
+ *          CONSOLE_BLOCK bytes is written without waiting for a zero.
+ * @param   [in] const void * data: bytes to add
+ *          [in] int size: number of bytes
+ */
+void consoleBytes(const void * data, int size)
+{
+    const unsigned char * bytes = data;
+
+    while(size--)
+    {
+        if(*bytes)
+        {
+            block[blockSize++] = *bytes;
+            if(blockSize == CONSOLE_BLOCK)
+            {
+                blockWrite(CONSOLE_BLOCK + 1);
+            }
+        }
+        else
+        {
+            blockWrite(blockSize + 1);
+        }
+        bytes++;
+    }
+}
+
+/*
+ * @brief   Ends the open record with its last block and the zero
+ *          delimiter
+ */
+void consoleEnd(void)
+{
+    blockWrite(blockSize + 1);
+    UART_PUTCHAR(NUL);
+    recordOpen = FALSE;
+}
+
+/*
+ * @brief   Starts a record with its type and timestamp, ending any
+ *          record left open
+ * @param   [in] int type: record type, enum consolerecords
+ */
+void consoleBegin(int type)
+{
+    unsigned long stamp = CYCLE_COUNT();
+    unsigned char header[1 + TIMESTAMP_BYTES];
+    int i;
+
+    if(recordOpen)
+    {
+        consoleEnd();
+    }
+    recordOpen = TRUE;
+    recordType = type;
+
+    header[0] = (unsigned char)type;
+    for(i = 0; i < TIMESTAMP_BYTES; i++)
+    {
+        header[1 + i] = (unsigned char)((stamp >> (i * BYTE_BITS)) & BYTE_MASK);
+    }
+    consoleBytes(header, sizeof(header));
+}
+
+/*
+ * @brief   Adds a number to the open record, seven bits a byte, least
+ *          significant first, so small numbers take one byte
+ * @param   [in] unsigned long value: number to add
+ */
+void consoleNumber(unsigned long value)
+{
+    unsigned char group;
+
+    do
+    {
+        group = (unsigned char)(value & (NUMBER_MORE - 1));
+        value >>= CONSOLE_NUMBER_BITS;
+        if(value)
+        {
+            group |= NUMBER_MORE;
+        }
+        consoleBytes(&group, 1);
+    } while(value);
+}
+
+/*
+ * @brief   Writes a character of text in binary mode, a line to each
+ *          CONSOLE_TEXT_LINE record. Called by forceOutput().
+ * @param   [in] char data: character written
+ */
+void consoleText(char data)
+{
+    if(!recordOpen || recordType != CONSOLE_TEXT_LINE)
+    {
+        consoleBegin(CONSOLE_TEXT_LINE);
+    }
+    consoleBytes(&data, 1);
+    if(data == '\n')
+    {
+        consoleEnd();
+    }
+}
+
+/*
+ * @brief   Returns the console mode
+ * @return  int: CONSOLE_TEXT or CONSOLE_BINARY
+ */
+int getConsoleMode(void)
+{
+    return consoleMode;
+}
+
+/*
+ * @brief   Sets the console mode, ending a record left open
+ * @param   [in] int mode: CONSOLE_TEXT or CONSOLE_BINARY
+ */
+void setConsoleMode(int mode)
+{
+    if(recordOpen)
+    {
+        consoleEnd();
+    }
+    consoleMode = mode;
+}
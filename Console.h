@@ -0,0 +1,62 @@
+/*
+ * @file    Console.h
+ * @brief   Console output modes.
+ *          In CONSOLE_TEXT mode UART0 carries text as it always has. In
+ *          CONSOLE_BINARY mode it carries records, each
+ *              type timestamp payload
+ *          with the DWT cycle count as a 32-bit little-endian timestamp,
+ *          COBS encoded so the only zero byte on the wire ends a record.
+ *          The UART process writes the messages it receives as
+ *          CONSOLE_MESSAGE records, unchanged, so any payload can be
+ *          streamed; benchmark results and trace dumps are written as
+ *          packed numbers instead of formatted text. Text written with
+ *          forceOutput() is framed a line at a time as CONSOLE_TEXT_LINE
+ *          records, so existing dumps still reach the host intact.
+ *          tools/console_decode.py renders the records on the host.
+ *          Building with KERNEL_CONSOLE_BINARY starts in binary mode.
+ *          Records are written by one process at a time, as text is.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+
+enum consolemodes {CONSOLE_TEXT, CONSOLE_BINARY};
+
+#ifdef KERNEL_CONSOLE_BINARY
+#define CONSOLE_DEFAULT_MODE    CONSOLE_BINARY
+#else
+#define CONSOLE_DEFAULT_MODE    CONSOLE_TEXT
+#endif
+
+/*
+ * Record types, the first byte of a record. Payloads:
+ *  CONSOLE_TEXT_LINE:  characters up to and including '\n'
+ *  CONSOLE_MESSAGE:    sender's mailbox, 16-bit little-endian, then
+ *                      each message merged from it: its size, a number
+ *                      as below, and its bytes exactly as received
+ *  CONSOLE_BENCH:      parameter, samples, min, mean and max as
+ *                      CONSOLE_NUMBER_BITS-bit groups (LEB128), then
+ *                      the test name
+ *  CONSOLE_TRACE:      head and count, 32-bit little-endian, then the
+ *                      TraceEvents, oldest first
+ */
+enum consolerecords {CONSOLE_TEXT_LINE = 1, CONSOLE_MESSAGE, CONSOLE_BENCH, CONSOLE_TRACE};
+
+/* Largest run of non-zero bytes one COBS code byte covers */
+#define CONSOLE_BLOCK           254
+/* Bits of a number per byte; the top bit marks more bytes follow */
+#define CONSOLE_NUMBER_BITS     7
+
+#ifndef GLOBAL_CONSOLE
+#define GLOBAL_CONSOLE
+
+extern int getConsoleMode(void);
+extern void setConsoleMode(int);
+extern void consoleBegin(int);
+extern void consoleBytes(const void *, int);
+extern void consoleNumber(unsigned long);
+extern void consoleEnd(void);
+extern void consoleText(char);
+
+#endif /* GLOBAL_CONSOLE */
@@ -0,0 +1,19 @@
+/*
+ * @file    DWT.c
+ * @brief   Contains DWT cycle counter initialization
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_DWT
+#include "DWT.h"
+
+/*
+ * @brief   Enable the trace block and start the cycle counter from zero
+ */
+void initCycleCounter(void)
+{
+    DEMCR_R |= DEMCR_TRCENA;
+    DWT_CYCCNT_R = 0;
+    DWT_CTRL_R |= DWT_CTRL_CYCCNTENA;
+}
@@ -0,0 +1,34 @@
+/*
+ * @file    DWT.h
+ * @brief   Data Watchpoint and Trace (DWT) cycle counter
+ *          register definitions and function prototypes.
+ *          CYCCNT is a free running 32-bit counter clocked
+ *          by the core, used to timestamp kernel events.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Hardware.h"
+
+// Debug Exception and Monitor Control Register
+#define DEMCR_R         HW_REGISTER(0xE000EDFC)
+// DWT Control Register
+#define DWT_CTRL_R      HW_REGISTER(0xE0001000)
+// DWT Cycle Count Register
+#define DWT_CYCCNT_R    HW_REGISTER(0xE0001004)
+
+#define DEMCR_TRCENA        0x01000000  // Enable DWT and ITM blocks
+#define DWT_CTRL_CYCCNTENA  0x00000001  // Enable cycle counter
+
+/* Current core cycle count; Hardware.h may substitute its own */
+#ifndef CYCLE_COUNT
+#define CYCLE_COUNT()   (DWT_CYCCNT_R)
+#endif
+
+#ifndef GLOBAL_DWT
+#define GLOBAL_DWT
+
+    extern void initCycleCounter(void);
+
+#endif // GLOBAL_DWT
@@ -0,0 +1,165 @@
+/*
+ * @file    EDF.c
+ * @brief   Contains the deadline heap of the EDF scheduling class,
+ *          job release/completion and deadline miss accounting
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_EDF
+#include "EDF.h"
+#include "SVC.h"
+#include "SYSTICK.h"
+#include "Utilities.h"
+
+#define PARENT(i)   (((i) - 1) / 2)
+#define LEFT(i)     (2 * (i) + 1)
+
+/* Ready EDF processes other than the earliest, as a binary min heap on deadline */
+PRIVATE PCB * heap[EDF_PROCESSES];
+PRIVATE int heapSize = 0;
+
+/*
+ * @brief   Stores a PCB at a heap position
+ * @param   [in] int index: heap position
+ *          [in/out] PCB * process: PCB stored there
+ */
+PRIVATE void heapPlace(int index, PCB * process)
+{
+    heap[index] = process;
+    process->heapIndex = index;
+}
+
+/*
+ * @brief   Moves the PCB at a heap position towards the root until
+ *          its parent's deadline is not later than its own
+ * @param   [in] int index: heap position
+ */
+PRIVATE void siftUp(int index)
+{
+    PCB * process = heap[index];
+
+    while(index > 0 && DEADLINE_BEFORE(process->deadline, heap[PARENT(index)]->deadline))
+    {
+        heapPlace(index, heap[PARENT(index)]);
+        index = PARENT(index);
+    }
+    heapPlace(index, process);
+}
+
+/*
+ * @brief   Moves the PCB at a heap position towards the leaves until
+ *          neither child has an earlier deadline
+ * @param   [in] int index: heap position
+ */
+PRIVATE void siftDown(int index)
+{
+    PCB * process = heap[index];
+    int child;
+
+    while((child = LEFT(index)) < heapSize)
+    {
+        if(child + 1 < heapSize &&
+           DEADLINE_BEFORE(heap[child + 1]->deadline, heap[child]->deadline))
+        {
+            child++;
+        }
+        if(!DEADLINE_BEFORE(heap[child]->deadline, process->deadline))
+        {
+            break;
+        }
+        heapPlace(index, heap[child]);
+        index = child;
+    }
+    heapPlace(index, process);
+}
+
+/*
+ * @brief   Adds a ready EDF process to the deadline heap
+ * @param   [in/out] PCB * process: process added
+ */
+void edfInsert(PCB * process)
+{
+    heapPlace(heapSize++, process);
+    siftUp(process->heapIndex);
+}
+
+/*
+ * @brief   Removes the EDF process with the earliest deadline from the heap
+ * @return  PCB *: the process, NULL if the heap is empty
+ */
+PCB * edfPop(void)
+{
+    PCB * earliest;
+
+    if(!heapSize)
+    {
+        return NULL;
+    }
+
+    earliest = heap[0];
+    edfRemove(earliest);
+    return earliest;
+}
+
+/*
+ * @brief   Removes any EDF process from the heap
+ * @param   [in/out] PCB * process: process removed
+ */
+void edfRemove(PCB * process)
+{
+    int index = process->heapIndex;
+
+    heapSize--;
+    if(index != heapSize)
+    {
+        /* The last entry fills the hole and moves whichever way it must */
+        PCB * moved = heap[heapSize];
+
+        heapPlace(index, moved);
+        siftUp(index);
+        siftDown(moved->heapIndex);
+    }
+}
+
+/*
+ * @brief   Starts a new job of an EDF or periodic process
+ * @param   [in/out] PCB * process: process being released
+ *          [in] unsigned long release: tick of the release
+ */
+void edfRelease(PCB * process, unsigned long release)
+{
+    process->release = release;
+    process->deadline = release + process->relativeDeadline;
+    process->deadlineMissed = FALSE;
+}
+
+/*
+ * @brief   Counts a deadline miss, once per job, if the current job
+ *          of an EDF process is past its deadline. Called when the job
+ *          completes (the process blocks or exits) and while it runs.
+ * @param   [in/out] PCB * process: EDF process of interest
+ */
+void edfCheckDeadline(PCB * process)
+{
+    if(!process->deadlineMissed && DEADLINE_BEFORE(process->deadline, sysTicks()))
+    {
+        process->deadlineMisses++;
+        process->deadlineMissed = TRUE;
+    }
+}
+
+/*
+ * @brief   Called from SYSTICKHandler. Counts a miss as soon as the
+ *          running EDF job passes its deadline; it has the earliest
+ *          deadline, so no other job can have missed before it.
+ */
+void edfTick(void)
+{
+    PCB * running = getRunningPCB();
+
+    if(IS_EDF(running))
+    {
+        edfCheckDeadline(running);
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ * @file    EDF.h
+ * @brief   Earliest deadline first scheduling class.
+ *          EDF processes are registered with a period and a relative
+ *          deadline (SysTick ticks) and run at EDF_PRIORITY, a queue
+ *          level above HIGH_PRIORITY: while any is ready, no fixed
+ *          priority process runs. Of the ready EDF processes, the one
+ *          with the earliest absolute deadline is the only entry of
+ *          waitingToRun[EDF_PRIORITY]; the others wait in a heap
+ *          ordered by deadline.
+ *          A job is released when the process is registered or woken
+ *          by a message and completes when it blocks again.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Process.h"
+
+/* Queue level of the EDF class, above the fixed priorities */
+#define EDF_PRIORITY        PRIORITY_LEVELS
+/* Most EDF processes registered at once (heap capacity) */
+#define EDF_PROCESSES       16
+
+/* Tick a is earlier than tick b, allowing for wrap around */
+#define DEADLINE_BEFORE(a, b)   ((long)((a) - (b)) < 0)
+#define IS_EDF(pcb)             ((pcb)->basePriority == EDF_PRIORITY)
+
+#ifndef GLOBAL_EDF
+#define GLOBAL_EDF
+
+extern void edfInsert(PCB *);
+extern PCB * edfPop(void);
+extern void edfRemove(PCB *);
+extern void edfRelease(PCB *, unsigned long);
+extern void edfCheckDeadline(PCB *);
+extern void edfTick(void);
+
+#else
+
+void edfRemove(PCB *);
+
+#endif /* GLOBAL_EDF */
@@ -0,0 +1,144 @@
+/*
+ * @file    Events.c
+ * @brief   Contains the kernel side of event flags: setting them,
+ *          blocking a process on them and waking it
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_EVENTS
+#include "Events.h"
+#include "SVC.h"
+#include "Timer.h"
+#include "MLFQ.h"
+#include "DWT.h"
+#include "Utilities.h"
+
+/* Flags are 32 bits on every build */
+#define EVENT_BITS      0xFFFFFFFFUL
+
+/*
+ * @brief   Finds the flags of a mask that satisfy a wait
+ * @param   [in] unsigned long flags: a process' flags
+ *          [in] unsigned long mask: flags waited on
+ *          [in] int mode: EVENT_ANY or EVENT_ALL, with EVENT_KEEP
+ * @return  unsigned long: flags of mask that are set; 0 if the wait is
+ *                         not satisfied
+ */
+PRIVATE unsigned long eventMatch(unsigned long flags, unsigned long mask, int mode)
+{
+    unsigned long matched = flags & mask;
+
+    return (mode & EVENT_ALL) ? ((matched == mask) ? matched : 0) : matched;
+}
+
+/*
+ * @brief   Ends a wait: clears the flags it matched unless EVENT_KEEP
+ *          was given
+ * @param   [in/out] PCB * process: process whose wait is satisfied
+ *          [in] unsigned long matched: flags returned to it
+ *          [in] int mode: mode of the wait
+ * @return  int: matched, as returned by eventWait()
+ */
+PRIVATE int eventConsume(PCB * process, unsigned long matched, int mode)
+{
+    if(!(mode & EVENT_KEEP))
+    {
+        process->eventFlags &= ~matched;
+    }
+    return (int)matched;
+}
+
+/*
+ * @brief   Makes a process blocked in eventWait() ready
+ * @param   [in/out] PCB * process: process woken
+ *          [in] int value: value its eventWait() returns
+ */
+PRIVATE void eventWake(PCB * process, int value)
+{
+    process->eventMask = 0;
+    *(process->returnValue) = value;
+    process->blockedCycles += CYCLE_COUNT() - process->blockedAt;
+    addPCB(process, process->priority);
+}
+
+/*
+ * @brief   Sets flags of a process and wakes it if it is waiting on
+ *          them. Called for eventSet() and by isrDrain().
+ * @param   [in] unsigned int pid: process whose flags are set
+ *          [in] unsigned long flags: flags OR'd into its word
+ * @return  int: SUCCESS; FAILURE if there is no such process
+ */
+int kernelEventSet(unsigned int pid, unsigned long flags)
+{
+    PCB * process = findProcess(pid);
+    unsigned long matched;
+
+    if(!process)
+    {
+        return FAILURE;
+    }
+
+    process->eventFlags |= flags & EVENT_BITS;
+    if(process->eventMask)
+    {
+        matched = eventMatch(process->eventFlags, process->eventMask, process->eventMode);
+        if(matched)
+        {
+            eventTimerCancel(process);
+            eventWake(process, eventConsume(process, matched, process->eventMode));
+        }
+    }
+    return SUCCESS;
+}
+
+/*
+ * @brief   Returns the caller's flags if they satisfy its wait, else
+ *          blocks it, with a timer if the wait has a timeout
+ * @param   [in/out] PCB * caller: the RUNNING process
+ *          [in] EventWait * wait: flags, mode and timeout waited with
+ *          [out] int * returnValue: matched flags, 0 on a timeout, a
+ *                zero mask or when no timer is free
+ * @return  int: TRUE if the caller blocked
+ */
+int kernelEventWait(PCB * caller, EventWait * wait, int * returnValue)
+{
+    unsigned long mask = wait->mask & EVENT_BITS;
+    unsigned long matched = eventMatch(caller->eventFlags, mask, wait->mode);
+
+    *returnValue = 0;
+    if(matched)
+    {
+        *returnValue = eventConsume(caller, matched, wait->mode);
+        return FALSE;
+    }
+    if(!mask || wait->timeout == EVENT_POLL)
+    {
+        return FALSE;
+    }
+    if(wait->timeout > 0 && eventTimerStart(caller, wait->timeout) == FAILURE)
+    {
+        return FALSE;
+    }
+
+    removePCB();
+    caller->eventMask = mask;
+    caller->eventMode = wait->mode;
+    caller->returnValue = returnValue;
+    caller->blockedAt = CYCLE_COUNT();
+    mlfqBlock(caller);
+    return TRUE;
+}
+
+/*
+ * @brief   Called by timerExpire() when a wait's timer expires: the
+ *          process' eventWait() returns 0
+ * @param   [in/out] PCB * process: process whose wait timed out
+ */
+void eventTimeout(PCB * process)
+{
+    if(process->eventMask)
+    {
+        eventWake(process, 0);
+    }
+}
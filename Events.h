@@ -0,0 +1,48 @@
+/*
+ * @file    Events.h
+ * @brief   Per-process event flags.
+ *          Every process has a 32-bit word of event flags. eventSet()
+ *          ORs flags into a process' word; a kernel-aware handler does
+ *          the same with isrEventSet(), which pendSV applies. Neither
+ *          takes a message from the pool.
+ *          eventWait() returns the flags of its mask that are set, once
+ *          any (EVENT_ANY) or all (EVENT_ALL) of them are, and clears
+ *          them unless EVENT_KEEP is given. Until then the caller is
+ *          blocked: the set that satisfies it makes it ready directly,
+ *          or its timeout, in SysTick ticks, returns 0.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Process.h"
+
+/* eventWait() modes; EVENT_KEEP may be OR'd with either */
+#define EVENT_ANY           0x0
+#define EVENT_ALL           0x1
+#define EVENT_KEEP          0x2
+
+/* eventWait() timeouts besides a number of ticks */
+#define EVENT_FOREVER       -1
+#define EVENT_POLL          0
+
+/*
+ * @brief   Event Wait Kernel Call Arguments
+ * @details Holds all variables passed to kernel
+ *          for when a process waits on its flags
+ */
+typedef struct EventWait_
+{
+    unsigned long mask;
+    int mode;
+    int timeout;
+}EventWait;
+
+#ifndef GLOBAL_EVENTS
+#define GLOBAL_EVENTS
+
+extern int kernelEventSet(unsigned int, unsigned long);
+extern int kernelEventWait(PCB *, EventWait *, int *);
+extern void eventTimeout(PCB *);
+
+#endif /* GLOBAL_EVENTS */
@@ -0,0 +1,49 @@
+/*
+ * @file    Hardware.h
+ * @brief   Memory mapped register access and the core instructions
+ *          the kernel uses. Every peripheral and system control
+ *          register is reached through HW_REGISTER() and every
+ *          instruction through the macros below, so a hosted build
+ *          (HOST_PORT) can substitute host/HostPort.h for the TM4C1294.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+
+#ifdef HOST_PORT
+
+#include "host/HostPort.h"
+
+#else
+
+#define HW_REGISTER(address)    (*((volatile unsigned long *)(address)))
+
+#define SVC()       __asm(" SVC #0")
+#define disable()   __asm(" cpsid i")   //disable interrupts
+#define enable()    __asm(" cpsie i")   //enable interrupts
+/* Masks interrupts of priority value >= value (Interrupts.h); 0 masks none */
+#define SET_BASEPRI(value)  set_BASEPRI(value)  // Process.c
+
+/* Loads r7 with the kernel call argument pointer; must be the only
+ * statement of a function receiving the pointer as its first argument (r0) */
+#define ASSIGN_R7(data)     __asm("     mov     r7,r0")
+
+/* Memory barrier: no access, by the compiler or the core, is moved
+ * across it */
+#define DMB()       __asm(" dmb")
+
+/* Stores value at address if it holds expected, with an LDREX/STREX
+ * pair retried until no exception comes between them; TRUE if stored */
+#define COMPARE_AND_SWAP(address, expected, value)  compare_and_swap(address, expected, value)  // Process.c
+
+/* Exception return to Thread mode using the PSP (FFFF.FFFD in LR) */
+#define RETURN_TO_PSP()                                                     \
+    do                                                                      \
+    {                                                                       \
+        __asm(" movw    LR,#0xFFFD");  /* Lower 16 [and clear top 16] */    \
+        __asm(" movt    LR,#0xFFFF");  /* Upper 16 only */                  \
+        __asm(" bx  LR");              /* Force return to PSP */            \
+    } while(0)
+
+#endif /* HOST_PORT */
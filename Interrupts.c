@@ -0,0 +1,210 @@
+/*
+ * @file    Interrupts.c
+ * @brief   Contains NVIC priority setup and the interrupt latency
+ *          probes of the kernel-aware and zero-latency classes
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_INTERRUPTS
+#include <string.h>
+#include "Interrupts.h"
+#include "KernelCall.h"
+#include "Process.h"
+#include "UART.h"
+#include "Messages.h"
+#include "Utilities.h"
+#include "Events.h"
+
+/* Entry latency of each class, written only by its probe handler */
+PRIVATE LatencyHistogram irqLatency[IRQ_CLASSES];
+/* Messages posted by handlers and not yet sent by pendSV */
+PRIVATE IsrPost isrPosts[ISR_POSTS];
+PRIVATE IsrEvent isrEvents[ISR_EVENTS];
+
+/*
+ * @brief   Sets the priority of a peripheral interrupt
+ * @param   [in] unsigned long irq: interrupt number (INT_VEC_...)
+ *          [in] int level: 0 (most urgent) to LOWEST_IRQ_LEVEL
+ */
+void setInterruptPriority(unsigned long irq, int level)
+{
+    NVIC_PRI_R(irq) = (NVIC_PRI_R(irq) & ~(0xFFUL << NVIC_PRI_SHIFT(irq)))
+                      | (IRQ_PRIORITY(level) << NVIC_PRI_SHIFT(irq));
+}
+
+/*
+ * @brief   Starts one probe timer interrupting every period cycles
+ * @param   [in] int timer: timer module
+ *          [in] unsigned long irq: its Timer A interrupt number
+ *          [in] int level: priority of the interrupt
+ *          [in] unsigned long period: cycles between time-outs
+ */
+PRIVATE void startProbe(int timer, unsigned long irq, int level, unsigned long period)
+{
+    SYSCTL_RCGCTIMER_R |= 1UL << timer;
+    TIMER_CTL_R(timer) &= ~TIMER_CTL_TAEN;
+    TIMER_CFG_R(timer) = TIMER_CFG_32_BIT;
+    TIMER_TAMR_R(timer) = TIMER_TAMR_PERIODIC;
+    TIMER_TAILR_R(timer) = period - 1;
+    TIMER_ICR_R(timer) = TIMER_INT_TATO;
+    TIMER_IMR_R(timer) |= TIMER_INT_TATO;
+    setInterruptPriority(irq, level);
+    InterruptEnable(irq);
+    TIMER_CTL_R(timer) |= TIMER_CTL_TAEN;
+}
+
+/*
+ * @brief   Starts the probe of each class. Called from main() before
+ *          the first process runs.
+ */
+void initLatencyProbes(void)
+{
+    startProbe(PROBE_KERNEL_TIMER, INT_VEC_TIMER0A, KERNEL_IRQ_LEVEL, PROBE_KERNEL_PERIOD);
+    startProbe(PROBE_ZERO_TIMER, INT_VEC_TIMER1A, ZERO_LATENCY_LEVEL, PROBE_ZERO_PERIOD);
+}
+
+/*
+ * @brief   Timer 0A ISR: kernel-aware probe
+ */
+void ProbeKernelHandler(void)
+{
+    unsigned long elapsed = PROBE_ELAPSED(PROBE_KERNEL_TIMER);
+
+    TIMER_ICR_R(PROBE_KERNEL_TIMER) = TIMER_INT_TATO;
+    latencyRecord(&irqLatency[IRQ_KERNEL_AWARE], elapsed);
+}
+
+/*
+ * @brief   Timer 1A ISR: zero-latency probe
+ */
+void ProbeZeroHandler(void)
+{
+    unsigned long elapsed = PROBE_ELAPSED(PROBE_ZERO_TIMER);
+
+    TIMER_ICR_R(PROBE_ZERO_TIMER) = TIMER_INT_TATO;
+    latencyRecord(&irqLatency[IRQ_ZERO_LATENCY], elapsed);
+}
+
+/*
+ * @brief   Copies the entry latency histogram of an interrupt class
+ * @param   [in] unsigned long irqClass: enum irqclasses
+ *          [out] LatencyHistogram * histogram: destination
+ * @return  int: SUCCESS or FAILURE if irqClass is not a class
+ */
+int kernelIrqLatency(unsigned long irqClass, LatencyHistogram * histogram)
+{
+    if(irqClass >= IRQ_CLASSES)
+    {
+        return FAILURE;
+    }
+
+    memcpy(histogram, &irqLatency[irqClass], sizeof(LatencyHistogram));
+    return SUCCESS;
+}
+
+/*
+ * @brief   Asks pendSV to send an empty message; called from kernel-aware
+ *          handlers only. pendSV does not run until they return, but a
+ *          handler may be preempted by one at a more urgent level.
+ * @param   [in] int MB: mailbox to send to
+ *          [in] int fromMB: sender reported to its receiver
+ * @return  int: SUCCESS, also if the same post is already waiting;
+ *               FAILURE if ISR_POSTS others are
+ */
+int isrPost(int MB, int fromMB)
+{
+    int i;
+
+    for(i = 0; i < ISR_POSTS; i++)
+    {
+        if(isrPosts[i].state == ISR_SLOT_PENDING &&
+           isrPosts[i].MB == MB && isrPosts[i].fromMB == fromMB)
+        {
+            return SUCCESS;
+        }
+    }
+
+    /* A preempting handler cannot claim the same free slot */
+    for(i = 0; i < ISR_POSTS; i++)
+    {
+        if(COMPARE_AND_SWAP(&isrPosts[i].state, ISR_SLOT_FREE, ISR_SLOT_CLAIMED))
+        {
+            isrPosts[i].MB = MB;
+            isrPosts[i].fromMB = fromMB;
+            isrPosts[i].state = ISR_SLOT_PENDING;
+            ISR_PENDSV();
+            return SUCCESS;
+        }
+    }
+    return FAILURE;
+}
+
+/*
+ * @brief   Asks pendSV to set event flags of a process; called from
+ *          kernel-aware handlers only, as isrPost()
+ * @param   [in] unsigned int pid: process whose flags are set
+ *          [in] unsigned long flags: flags to set
+ * @return  int: SUCCESS, also if flags for the process are already
+ *               waiting; FAILURE if ISR_EVENTS other processes' are
+ */
+int isrEventSet(unsigned int pid, unsigned long flags)
+{
+    unsigned long old;
+    int i;
+
+    for(i = 0; i < ISR_EVENTS; i++)
+    {
+        if(isrEvents[i].state == ISR_SLOT_PENDING && isrEvents[i].pid == pid)
+        {
+            /* A preempting handler may be setting flags of the same slot */
+            do
+            {
+                old = isrEvents[i].flags;
+            } while(!COMPARE_AND_SWAP(&isrEvents[i].flags, old, old | flags));
+            return SUCCESS;
+        }
+    }
+
+    for(i = 0; i < ISR_EVENTS; i++)
+    {
+        if(COMPARE_AND_SWAP(&isrEvents[i].state, ISR_SLOT_FREE, ISR_SLOT_CLAIMED))
+        {
+            isrEvents[i].pid = pid;
+            isrEvents[i].flags = flags;
+            isrEvents[i].state = ISR_SLOT_PENDING;
+            ISR_PENDSV();
+            return SUCCESS;
+        }
+    }
+    return FAILURE;
+}
+
+/*
+ * @brief   Sends the messages and sets the event flags handlers have
+ *          posted. Called by pendSV with the kernel-aware interrupts
+ *          masked.
+ */
+void isrDrain(void)
+{
+    unsigned long flags;
+    int i;
+
+    for(i = 0; i < ISR_POSTS; i++)
+    {
+        if(isrPosts[i].state == ISR_SLOT_PENDING)
+        {
+            isrPosts[i].state = ISR_SLOT_FREE;
+            kernelPost(isrPosts[i].MB, isrPosts[i].fromMB, (void *)&isrPosts[i], 0);
+        }
+    }
+    for(i = 0; i < ISR_EVENTS; i++)
+    {
+        if(isrEvents[i].state == ISR_SLOT_PENDING)
+        {
+            flags = isrEvents[i].flags;
+            isrEvents[i].state = ISR_SLOT_FREE;
+            kernelEventSet(isrEvents[i].pid, flags);
+        }
+    }
+}
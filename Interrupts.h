@@ -0,0 +1,131 @@
+/*
+ * @file    Interrupts.h
+ * @brief   Interrupt priority classes and the interrupt latency probes.
+ *          The NVIC of the TM4C1294 implements PRIORITY_BITS bits of
+ *          priority: levels 0 (most urgent) to 7.
+ *              - levels below KERNEL_IRQ_LEVEL are zero-latency: the
+ *                kernel never masks them, so their handlers must not
+ *                make kernel calls or touch kernel data
+ *              - levels from KERNEL_IRQ_LEVEL down are kernel-aware:
+ *                SVCall and SysTick run at KERNEL_IRQ_LEVEL, so none of
+ *                them preempts the kernel, and pendSV masks them with
+ *                BASEPRI (KERNEL_MASK()) rather than disabling every
+ *                interrupt
+ *          Building with --define=KERNEL_IRQ_LEVEL=<n> moves the threshold.
+ *          The probes are two periodic timers, one per class, whose
+ *          handlers record how long after its timeout each was entered;
+ *          getIrqLatency() reads the histograms.
+ *          A kernel-aware handler wakes a process with isrPost(): the
+ *          empty message is sent by pendSV, after the interrupted
+ *          process is saved, so the woken one can preempt it.
+ *          Repeated posts before then are merged into one.
+ *          isrEventSet() likewise sets event flags (Events.h): flags set
+ *          for the same process before pendSV runs are OR'd together.
+ *          Handlers at different kernel-aware levels preempt each other,
+ *          so both claim their slots with COMPARE_AND_SWAP (Hardware.h);
+ *          a post made while another handler is still filling a slot
+ *          for the same mailbox may be sent twice, but none is lost.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Hardware.h"
+
+struct LatencyHistogram_;
+
+/* Implemented priority bits, held in the top of each 8-bit priority field */
+#define PRIORITY_BITS       3
+#define IRQ_PRIORITY(level) ((unsigned long)(level) << (8 - PRIORITY_BITS))
+#define LOWEST_IRQ_LEVEL    ((1 << PRIORITY_BITS) - 1)
+
+/* Most urgent kernel-aware level */
+#ifndef KERNEL_IRQ_LEVEL
+#define KERNEL_IRQ_LEVEL    2
+#endif
+#define ZERO_LATENCY_LEVEL  0
+
+/* Masks the kernel-aware interrupts only; BASEPRI of 0 masks nothing */
+#define KERNEL_MASK()       SET_BASEPRI(IRQ_PRIORITY(KERNEL_IRQ_LEVEL))
+#define KERNEL_UNMASK()     SET_BASEPRI(0)
+
+/* NVIC Interrupt Priority Registers, four 8-bit fields per register */
+#define NVIC_PRI_R(irq)     HW_REGISTER(0xE000E400 + ((irq) & ~3UL))
+#define NVIC_PRI_SHIFT(irq) (((irq) & 3) * 8)
+
+/* General-Purpose Timers used as latency probes */
+#define SYSCTL_RCGCTIMER_R  HW_REGISTER(0x400FE604)
+#define TIMER_BASE(timer)   (0x40030000UL + ((unsigned long)(timer) << 12))
+#define TIMER_CFG_R(timer)  HW_REGISTER(TIMER_BASE(timer) + 0x000)
+#define TIMER_TAMR_R(timer) HW_REGISTER(TIMER_BASE(timer) + 0x004)
+#define TIMER_CTL_R(timer)  HW_REGISTER(TIMER_BASE(timer) + 0x00C)
+#define TIMER_IMR_R(timer)  HW_REGISTER(TIMER_BASE(timer) + 0x018)
+#define TIMER_ICR_R(timer)  HW_REGISTER(TIMER_BASE(timer) + 0x024)
+#define TIMER_TAILR_R(timer) HW_REGISTER(TIMER_BASE(timer) + 0x028)
+#define TIMER_TAV_R(timer)  HW_REGISTER(TIMER_BASE(timer) + 0x050)
+
+#define TIMER_CFG_32_BIT    0x00000000  // Concatenated 32-bit timer
+#define TIMER_TAMR_PERIODIC 0x00000002  // Periodic, counting down
+#define TIMER_CTL_TAEN      0x00000001  // Timer A enable
+#define TIMER_INT_TATO      0x00000001  // Timer A time-out interrupt
+
+/* Probe timers, their interrupt numbers and periods in cycles; the
+ * periods are prime so the probes drift across the kernel's activity */
+#define PROBE_KERNEL_TIMER  0
+#define PROBE_ZERO_TIMER    1
+#define INT_VEC_TIMER0A     19
+#define INT_VEC_TIMER1A     21
+#define PROBE_KERNEL_PERIOD 48017
+#define PROBE_ZERO_PERIOD   80021
+
+/* Notifications kernel-aware handlers may have waiting for pendSV */
+#define ISR_POSTS           8
+/* Processes handlers may have event flags waiting for pendSV for */
+#define ISR_EVENTS          8
+/* States of an isrPost()/isrEventSet() slot */
+enum isrslotstates {ISR_SLOT_FREE, ISR_SLOT_CLAIMED, ISR_SLOT_PENDING};
+/* Pends pendSV from a handler */
+#define ISR_PENDSV()        (HW_REGISTER(0xE000ED04) |= 0x10000000UL)
+
+/*
+ * @brief   ISR Post Structure
+ * @details An empty message a handler has asked pendSV to send
+ */
+typedef struct IsrPost_
+{
+    int MB;//mailbox to send to
+    int fromMB;//sender reported to its receiver
+    volatile unsigned long state;//enum isrslotstates, PENDING until sent
+}IsrPost;
+
+/*
+ * @brief   ISR Event Structure
+ * @details Event flags a handler has asked pendSV to set
+ */
+typedef struct IsrEvent_
+{
+    unsigned int pid;//process whose flags are set
+    volatile unsigned long flags;//flags to set
+    volatile unsigned long state;//enum isrslotstates, PENDING until set
+}IsrEvent;
+
+/* Cycles since a probe timer timed out; Hardware.h may substitute its own */
+#ifndef PROBE_ELAPSED
+#define PROBE_ELAPSED(timer)    (TIMER_TAILR_R(timer) - TIMER_TAV_R(timer))
+#endif
+
+enum irqclasses {IRQ_KERNEL_AWARE, IRQ_ZERO_LATENCY, IRQ_CLASSES};
+
+#ifndef GLOBAL_INTERRUPTS
+#define GLOBAL_INTERRUPTS
+
+extern void setInterruptPriority(unsigned long, int);
+extern void initLatencyProbes(void);
+extern void ProbeKernelHandler(void);
+extern void ProbeZeroHandler(void);
+extern int kernelIrqLatency(unsigned long, struct LatencyHistogram_ *);
+extern int isrPost(int, int);
+extern int isrEventSet(unsigned int, unsigned long);
+extern void isrDrain(void);
+
+#endif /* GLOBAL_INTERRUPTS */
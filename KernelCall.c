@@ -11,6 +11,12 @@
 #include "KernelCall.h"
 #include "Process.h"
 #include "Messages.h"
+#include "Profile.h"
+#include "Spawn.h"
+#include "Channel.h"
+#include "Rpc.h"
+#include "Events.h"
+#include "Sync.h"
 
 /*
  * @brief   Used to set R7, to point to Kernel Argument passed to SVC
@@ -19,7 +25,7 @@
  */
 void assignR7(volatile unsigned long data)
 {
-    __asm("     mov     r7,r0");
+    ASSIGN_R7(data);
 }
 
 /*
@@ -101,14 +107,234 @@ int getid(void)
 }
 
 /*
- * @brief   The address of this function is loaded into the processes
- *          LR at initialization. This is called when a process is completed
- *          for its' PCB and stack to be free'd
+ * @brief   Called from a process to retrieve a snapshot of the
+ *          accounting of every registered process
+ * @param   [out] ProcessStats * table: array receiving one entry per process
+ *          [in] int maxEntries: number of entries in table
+ * @return  int: number of entries written
  */
-void terminate(void)
+int ps(ProcessStats * table, int maxEntries)
+{
+    volatile KernelArgs psArgs; /* Volatile to actually reserve space on stack */
+    psArgs.code = GETSTATS;
+    psArgs.arg1 = (unsigned long)table;
+    psArgs.arg2 = maxEntries;
+
+    /* Assign address of psArgs to R7 */
+    assignR7((unsigned long) &psArgs);
+
+    SVC();
+
+    return psArgs.rtnvalue;
+}
+
+/*
+ * @brief   Called from a process to copy the latency histogram
+ *          of one kernel call code
+ * @param   [in] int code: kernel call code of interest
+ *          [out] LatencyHistogram * histogram: receives the histogram
+ * @return  int: 1 -> success; -1 -> invalid code
+ */
+int getLatency(int code, LatencyHistogram * histogram)
+{
+    volatile KernelArgs latencyArgs; /* Volatile to actually reserve space on stack */
+    latencyArgs.code = GETLATENCY;
+    latencyArgs.arg1 = code;
+    latencyArgs.arg2 = (unsigned long)histogram;
+
+    /* Assign address of latencyArgs to R7 */
+    assignR7((unsigned long) &latencyArgs);
+
+    SVC();
+
+    return latencyArgs.rtnvalue;
+}
+
+/*
+ * @brief   Called from a process to copy the entry latency histogram
+ *          of one interrupt class (Interrupts.h)
+ * @param   [in] int irqClass: IRQ_KERNEL_AWARE or IRQ_ZERO_LATENCY
+ *          [out] LatencyHistogram * histogram: receives the histogram
+ * @return  int: 1 -> success; -1 -> invalid class
+ */
+int getIrqLatency(int irqClass, LatencyHistogram * histogram)
+{
+    volatile KernelArgs latencyArgs; /* Volatile to actually reserve space on stack */
+    latencyArgs.code = GETIRQLATENCY;
+    latencyArgs.arg1 = irqClass;
+    latencyArgs.arg2 = (unsigned long)histogram;
+
+    /* Assign address of latencyArgs to R7 */
+    assignR7((unsigned long) &latencyArgs);
+
+    SVC();
+
+    return latencyArgs.rtnvalue;
+}
+
+/*
+ * @brief   Called from a process to read the occupancy statistics
+ *          of a mailbox
+ * @param   [in] int MB: mailbox of interest
+ *          [out] MailBoxStats * stats: receives the statistics
+ * @return  int: 1 -> success; -1 -> invalid mailbox
+ */
+int getMailBoxStats(int MB, MailBoxStats * stats)
+{
+    volatile KernelArgs statsArgs; /* Volatile to actually reserve space on stack */
+    statsArgs.code = GETMBSTATS;
+    statsArgs.arg1 = MB;
+    statsArgs.arg2 = (unsigned long)stats;
+
+    /* Assign address of statsArgs to R7 */
+    assignR7((unsigned long) &statsArgs);
+
+    SVC();
+
+    return statsArgs.rtnvalue;
+}
+
+/*
+ * @brief   Called from a process to read the free counts and
+ *          low-water marks of the message and receive log pools
+ * @param   [out] PoolStats * stats: receives the statistics
+ * @return  int: 1 -> success
+ */
+int getPoolStats(PoolStats * stats)
+{
+    volatile KernelArgs statsArgs; /* Volatile to actually reserve space on stack */
+    statsArgs.code = GETPOOLSTATS;
+    statsArgs.arg1 = (unsigned long)stats;
+
+    /* Assign address of statsArgs to R7 */
+    assignR7((unsigned long) &statsArgs);
+
+    SVC();
+
+    return statsArgs.rtnvalue;
+}
+
+/*
+ * @brief   Called from a process to read the PC-sampling profile
+ * @param   [in/out] ProfileWindow * window: buckets wanted and
+ *          where to copy them; receives the sample totals
+ * @return  int: number of buckets copied; -1 -> invalid first bucket
+ */
+int getProfile(ProfileWindow * window)
+{
+    volatile KernelArgs profileArgs; /* Volatile to actually reserve space on stack */
+    profileArgs.code = GETPROFILE;
+    profileArgs.arg1 = (unsigned long)window;
+
+    /* Assign address of profileArgs to R7 */
+    assignR7((unsigned long) &profileArgs);
+
+    SVC();
+
+    return profileArgs.rtnvalue;
+}
+
+/*
+ * @brief   Called from a process to set an option of a mailbox it owns
+ * @param   [in] int MB: mailbox to configure
+ *          [in] int option: one of enum mailboxoptions
+ *          [in] int value: new value of the option
+ * @return  int: 1 -> success; -1 -> not the owner, unknown option or
+ *               value out of range
+ */
+int mailboxControl(int MB, int option, int value)
+{
+    MailBoxControl controlArgs;
+    controlArgs.MB = MB;
+    controlArgs.option = option;
+    controlArgs.value = value;
+
+    return procKernelCall(MBCONTROL, &controlArgs);
+}
+
+/*
+ * @brief   Called by a periodic process (one registered with a period)
+ *          when its job is done; returns at its next release
+ * @return  int: 1 -> success; -1 -> the process has no period
+ */
+int waitNextPeriod(void)
+{
+    volatile KernelArgs periodArgs; /* Volatile to actually reserve space on stack */
+    periodArgs.code = WAITPERIOD;
+
+    /* Assign address of periodArgs to R7 */
+    assignR7((unsigned long) &periodArgs);
+
+    SVC();
+    return periodArgs.rtnvalue;
+}
+
+/*
+ * @brief   Starts a software timer that posts a TimerEvent (Timer.h)
+ *          to a mailbox owned by the caller
+ * @param   [in] int MB: mailbox posted to
+ *          [in] unsigned long ticks: SysTick ticks to the first expiry
+ *          [in] int periodic: TRUE to repeat every ticks
+ * @return  int: timer ID; -1 -> invalid arguments or no timer is free
+ */
+int timerStart(int MB, unsigned long ticks, int periodic)
+{
+    TimerStart timerArgs;
+    timerArgs.MB = MB;
+    timerArgs.ticks = ticks;
+    timerArgs.periodic = periodic;
+
+    return procKernelCall(TIMERSTART, &timerArgs);
+}
+
+/*
+ * @brief   Stops a software timer started by the caller
+ * @param   [in] int id: timer ID returned by timerStart()
+ * @return  int: 1 -> success; -1 -> not a running timer of the caller
+ */
+int timerCancel(int id)
+{
+    volatile KernelArgs cancelArgs; /* Volatile to actually reserve space on stack */
+    cancelArgs.code = TIMERCANCEL;
+    cancelArgs.arg1 = id;
+
+    /* Assign address of cancelArgs to R7 */
+    assignR7((unsigned long) &cancelArgs);
+
+    SVC();
+    return cancelArgs.rtnvalue;
+}
+
+/*
+ * @brief   Selects fixed priority rotation or the multilevel feedback
+ *          queue (MLFQ.h)
+ * @param   [in] int mode: SCHED_FIXED or SCHED_MLFQ
+ * @return  int: the previous mode; -1 -> unknown mode
+ */
+int schedulerMode(int mode)
+{
+    volatile KernelArgs modeArgs; /* Volatile to actually reserve space on stack */
+    modeArgs.code = SCHEDMODE;
+    modeArgs.arg1 = mode;
+
+    /* Assign address of modeArgs to R7 */
+    assignR7((unsigned long) &modeArgs);
+
+    SVC();
+    return modeArgs.rtnvalue;
+}
+
+/*
+ * @brief   Ends the calling process. Its PCB and stack return to the
+ *          process pool; a spawned process' code is kept for join()
+ * @param   [in] int code: exit code, non-negative so it cannot be
+ *          mistaken for JOIN_FAIL
+ */
+void exitProcess(int code)
 {
     volatile KernelArgs terminateArg; /* Volatile to actually reserve space on stack */
     terminateArg.code = TERMINATE;
+    terminateArg.arg1 = code;
 
     /* Assign address of terminateArg to R7 */
     assignR7((unsigned long) &terminateArg);
@@ -116,6 +342,226 @@ void terminate(void)
     SVC();
 }
 
+/*
+ * @brief   The address of this function is loaded into the processes
+ *          LR at initialization. This is called when a process is completed
+ *          for its' PCB and stack to be free'd
+ */
+void terminate(void)
+{
+    exitProcess(0);
+}
+
+/*
+ * @brief   Creates a child process, which starts at entry(arg) and
+ *          ends by returning or calling exitProcess()
+ * @param   [in] void (*entry)(void *): code of the child
+ *          [in] int priority: LOW_PRIORITY to HIGH_PRIORITY
+ *          [in] unsigned long stackSize: bytes of stack it needs, at
+ *               most DEFAULT_STACK_SIZE
+ *          [in] void * arg: argument passed to entry
+ * @return  int: pid of the child; -1 -> invalid priority or the
+ *               process pool is exhausted
+ */
+int spawn(void (*entry)(void *), int priority, unsigned long stackSize, void * arg)
+{
+    SpawnArgs spawnArgs;
+    spawnArgs.entry = entry;
+    spawnArgs.priority = priority;
+    spawnArgs.stackSize = stackSize;
+    spawnArgs.arg = arg;
+
+    return procKernelCall(SPAWN, &spawnArgs);
+}
+
+/*
+ * @brief   Called by channelRead()/channelWrite() after setting their
+ *          waiting flag: blocks unless the ring has changed meanwhile
+ * @param   [in] Channel * channel: channel the caller cannot progress on
+ *          [in] int side: CHANNEL_READER or CHANNEL_WRITER
+ * @return  int: 1 -> blocked and since woken; 0 -> did not block;
+ *               -1 -> invalid side
+ */
+int channelBlock(Channel * channel, int side)
+{
+    volatile KernelArgs channelArgs; /* Volatile to actually reserve space on stack */
+    channelArgs.code = CHANNELBLOCK;
+    channelArgs.arg1 = (unsigned long)channel;
+    channelArgs.arg2 = side;
+
+    /* Assign address of channelArgs to R7 */
+    assignR7((unsigned long) &channelArgs);
+
+    SVC();
+
+    return channelArgs.rtnvalue;
+}
+
+/*
+ * @brief   Called by channelRead()/channelWrite() when the other side's
+ *          waiting flag is set: wakes it if it has blocked
+ * @param   [in] Channel * channel: channel progressed on
+ *          [in] int side: side to wake
+ * @return  int: 1 -> success; -1 -> invalid side
+ */
+int channelWake(Channel * channel, int side)
+{
+    volatile KernelArgs channelArgs; /* Volatile to actually reserve space on stack */
+    channelArgs.code = CHANNELWAKE;
+    channelArgs.arg1 = (unsigned long)channel;
+    channelArgs.arg2 = side;
+
+    /* Assign address of channelArgs to R7 */
+    assignR7((unsigned long) &channelArgs);
+
+    SVC();
+
+    return channelArgs.rtnvalue;
+}
+
+/*
+ * @brief   Called by semWait() after taking the count below zero: blocks
+ *          unless the semaphore was signalled meanwhile
+ * @param   [in] Semaphore * semaphore: semaphore of interest
+ * @return  int: 1 -> blocked and since woken; 0 -> did not block
+ */
+int semaphoreBlock(Semaphore * semaphore)
+{
+    volatile KernelArgs syncArgs; /* Volatile to actually reserve space on stack */
+    syncArgs.code = SEMBLOCK;
+    syncArgs.arg1 = (unsigned long)semaphore;
+
+    /* Assign address of syncArgs to R7 */
+    assignR7((unsigned long) &syncArgs);
+
+    SVC();
+
+    return syncArgs.rtnvalue;
+}
+
+/*
+ * @brief   Called by semSignal() after finding the count below zero:
+ *          wakes the first waiter, or the next to block
+ * @param   [in] Semaphore * semaphore: semaphore of interest
+ * @return  int: 1 -> success
+ */
+int semaphoreWake(Semaphore * semaphore)
+{
+    volatile KernelArgs syncArgs; /* Volatile to actually reserve space on stack */
+    syncArgs.code = SEMWAKE;
+    syncArgs.arg1 = (unsigned long)semaphore;
+
+    /* Assign address of syncArgs to R7 */
+    assignR7((unsigned long) &syncArgs);
+
+    SVC();
+
+    return syncArgs.rtnvalue;
+}
+
+/*
+ * @brief   Called by mutexLock() when the mutex is held: blocks until
+ *          it is handed over, lending the caller's priority to its holder
+ * @param   [in] Mutex * mutex: mutex of interest
+ * @return  int: 1 -> blocked and since handed the mutex; 0 -> it was
+ *               free; -1 -> the caller already holds it
+ */
+int mutexBlock(Mutex * mutex)
+{
+    volatile KernelArgs syncArgs; /* Volatile to actually reserve space on stack */
+    syncArgs.code = MUTEXBLOCK;
+    syncArgs.arg1 = (unsigned long)mutex;
+
+    /* Assign address of syncArgs to R7 */
+    assignR7((unsigned long) &syncArgs);
+
+    SVC();
+
+    return syncArgs.rtnvalue;
+}
+
+/*
+ * @brief   Called by mutexUnlock() when processes wait on the mutex:
+ *          hands it to the first of them
+ * @param   [in] Mutex * mutex: mutex of interest
+ * @return  int: 1 -> success; -1 -> the caller does not hold it
+ */
+int mutexWake(Mutex * mutex)
+{
+    volatile KernelArgs syncArgs; /* Volatile to actually reserve space on stack */
+    syncArgs.code = MUTEXWAKE;
+    syncArgs.arg1 = (unsigned long)mutex;
+
+    /* Assign address of syncArgs to R7 */
+    assignR7((unsigned long) &syncArgs);
+
+    SVC();
+
+    return syncArgs.rtnvalue;
+}
+
+/*
+ * @brief   Sets event flags of a process, waking it if it is waiting
+ *          on them
+ * @param   [in] int pid: process whose flags are set
+ *          [in] unsigned long flags: flags OR'd into its 32-bit word
+ * @return  int: 1 -> success; -1 -> no such process
+ */
+int eventSet(int pid, unsigned long flags)
+{
+    volatile KernelArgs eventArgs; /* Volatile to actually reserve space on stack */
+    eventArgs.code = EVENTSET;
+    eventArgs.arg1 = pid;
+    eventArgs.arg2 = flags;
+
+    /* Assign address of eventArgs to R7 */
+    assignR7((unsigned long) &eventArgs);
+
+    SVC();
+
+    return eventArgs.rtnvalue;
+}
+
+/*
+ * @brief   Waits until any or all of the caller's flags in a mask are
+ *          set, clearing those returned unless mode has EVENT_KEEP
+ * @param   [in] unsigned long mask: flags waited on
+ *          [in] int mode: EVENT_ANY or EVENT_ALL, optionally | EVENT_KEEP
+ *          [in] int timeout: ticks to wait, EVENT_FOREVER or EVENT_POLL
+ * @return  unsigned long: the flags of mask that are set; 0 -> timed
+ *                         out, mask is 0 or no timer is free
+ */
+unsigned long eventWait(unsigned long mask, int mode, int timeout)
+{
+    EventWait waitArgs;
+
+    waitArgs.mask = mask;
+    waitArgs.mode = mode;
+    waitArgs.timeout = timeout;
+
+    return (unsigned int)procKernelCall(EVENTWAIT, &waitArgs);
+}
+
+/*
+ * @brief   Waits for a child of the calling process to exit
+ * @param   [in] int pid: pid returned by spawn()
+ * @return  int: the child's exit code; -6 -> pid is not a child of the
+ *               caller, or has already been joined
+ */
+int join(int pid)
+{
+    volatile KernelArgs joinArgs; /* Volatile to actually reserve space on stack */
+    joinArgs.code = JOIN;
+    joinArgs.arg1 = pid;
+
+    /* Assign address of joinArgs to R7 */
+    assignR7((unsigned long) &joinArgs);
+
+    SVC();
+
+    return joinArgs.rtnvalue;
+}
+
 /*
  * @brief   Process calls nice function to change its priority level
  * @param   [in] int newPriority: the priority level the process is
@@ -146,7 +592,8 @@ int nice(int newPriority)
 
 
 /*
- * @brief   Invokes the kernel to send a message to a desired Mailbox
+ * @brief   Invokes the kernel to send a message to a desired Mailbox;
+ *          blocks while the mailbox is at its limit with MB_OVERLOAD_BLOCK
  * @param   [in] int destinationMB: MB # of the destination process
  *          [in] int fromMB: MB # of the sending process
  *          [in] void* contents: data to be sent
@@ -187,6 +634,146 @@ int recvMessage(int bindedMB, int * returnMB, void * contents, int maxSize)
     return procKernelCall( RECEIVEMSG, &recvArgs);
 }
 
+/*
+ * @brief   Receives a message already queued on a mailbox, without
+ *          blocking if there is none
+ * @param   [in] int bindedMB: MB # of the receiving process, or ANY
+ *          [out] int* returnMB: MB # of the process that sent the message
+ *          [in/out] void* contents: address where data is stored
+ *          [in] int maxSize: maximum amount of bytes the process will take
+ * @return  int: bytes copied; -7 -> nothing queued; -1 -> receive failure
+ */
+int pollMessage(int bindedMB, int * returnMB, void * contents, int maxSize)
+{
+    ReceiveMessage recvArgs;
+    recvArgs.bindedMB = bindedMB;
+    recvArgs.returnMB = returnMB;
+    recvArgs.contents =contents;
+    recvArgs.maxSize = maxSize;
+
+    return procKernelCall( POLLMSG, &recvArgs);
+}
+
+/*
+ * @brief   Sends a request to a server mailbox and waits for its reply,
+ *          in one kernel call; the caller needs no mailbox of its own
+ * @param   [in] int serverMB: mailbox the server receives requests on
+ *          [in] void * request: request data
+ *          [in] int size: bytes of request, at most RPC_LIMIT
+ *          [out] void * reply: receives the reply
+ *          [in] int maxSize: most bytes of reply wanted
+ * @return  int: bytes of reply copied; -1 -> request too large;
+ *               -2 -> send failure; -3 -> reply is NULL
+ */
+int rpcCall(int serverMB, void * request, int size, void * reply, int maxSize)
+{
+    RpcArgs rpcArgs;
+    rpcArgs.serverMB = serverMB;
+    rpcArgs.contents = request;
+    rpcArgs.size = size;
+    rpcArgs.reply = reply;
+    rpcArgs.maxSize = maxSize;
+
+    return procKernelCall(RPCCALL, &rpcArgs);
+}
+
+/*
+ * @brief   Sends a request to a server mailbox without waiting; the
+ *          reply is collected later with rpcWait()
+ * @param   [in] int serverMB: mailbox the server receives requests on
+ *          [in] void * request: request data
+ *          [in] int size: bytes of request, at most RPC_LIMIT
+ * @return  int: call ID; -1 -> request too large; -2 -> send failure
+ */
+int rpcSend(int serverMB, void * request, int size)
+{
+    RpcArgs rpcArgs;
+    rpcArgs.serverMB = serverMB;
+    rpcArgs.contents = request;
+    rpcArgs.size = size;
+
+    return procKernelCall(RPCSEND, &rpcArgs);
+}
+
+/*
+ * @brief   Collects the reply to a call made with rpcSend(), blocking
+ *          until it arrives
+ * @param   [in] int callId: ID returned by rpcSend()
+ *          [out] void * reply: receives the reply
+ *          [in] int maxSize: most bytes of reply wanted
+ * @return  int: bytes of reply copied; -3 -> not a call of the caller
+ *               or reply is NULL
+ */
+int rpcWait(int callId, void * reply, int maxSize)
+{
+    RpcArgs rpcArgs;
+    rpcArgs.callId = callId;
+    rpcArgs.reply = reply;
+    rpcArgs.maxSize = maxSize;
+
+    return procKernelCall(RPCWAIT, &rpcArgs);
+}
+
+/*
+ * @brief   Answers a request taken with rpcReceive()
+ * @param   [in] int callId: ID reported with the request
+ *          [in] void * reply: reply data
+ *          [in] int size: bytes of reply
+ * @return  int: 1 -> success; -2 -> the client has exited, the reply is
+ *               too large or the message pool is empty
+ */
+int rpcReply(int callId, void * reply, int size)
+{
+    RpcArgs rpcArgs;
+    rpcArgs.callId = callId;
+    rpcArgs.contents = reply;
+    rpcArgs.size = size;
+
+    return procKernelCall(RPCREPLY, &rpcArgs);
+}
+
+/*
+ * @brief   Registers a name other processes can find a mailbox by
+ * @param   [in] const char * name: 1 to NAME_LENGTH - 1 characters
+ *          [in] int MB: mailbox bound by the caller
+ * @return  int: 1 -> success; -1 -> not the caller's mailbox, invalid
+ *               or taken name, or the name table is full
+ */
+int registerName(const char * name, int MB)
+{
+    volatile KernelArgs nameArgs; /* Volatile to actually reserve space on stack */
+    nameArgs.code = NAMEREGISTER;
+    nameArgs.arg1 = (unsigned long)name;
+    nameArgs.arg2 = MB;
+
+    /* Assign address of nameArgs to R7 */
+    assignR7((unsigned long) &nameArgs);
+
+    SVC();
+
+    return nameArgs.rtnvalue;
+}
+
+/*
+ * @brief   Asks the kernel for the mailbox registered under a name;
+ *          lookupName() (Names.h) answers repeated lookups from its cache
+ * @param   [in] const char * name: name wanted
+ * @return  int: mailbox number; -1 -> no such name
+ */
+int resolveName(const char * name)
+{
+    volatile KernelArgs nameArgs; /* Volatile to actually reserve space on stack */
+    nameArgs.code = NAMELOOKUP;
+    nameArgs.arg1 = (unsigned long)name;
+
+    /* Assign address of nameArgs to R7 */
+    assignR7((unsigned long) &nameArgs);
+
+    SVC();
+
+    return nameArgs.rtnvalue;
+}
+
 
 
 
@@ -10,7 +10,21 @@
  */
 #pragma once
 
-enum kernelcallcodes {GETID, NICE, SENDMSG, RECEIVEMSG, TERMINATE, BIND, UNBIND};
+struct ProcessStats_;
+struct MailBoxStats_;
+struct PoolStats_;
+struct ProfileWindow_;
+struct Channel_;
+struct Semaphore_;
+struct Mutex_;
+
+enum kernelcallcodes {GETID, NICE, SENDMSG, RECEIVEMSG, TERMINATE, BIND, UNBIND, GETSTATS, GETLATENCY,
+                      GETMBSTATS, GETPOOLSTATS, GETPROFILE, MBCONTROL, WAITPERIOD, TIMERSTART,
+                      TIMERCANCEL, SCHEDMODE, GETIRQLATENCY, SPAWN, JOIN,
+                      CHANNELBLOCK, CHANNELWAKE, RPCCALL, RPCSEND, RPCWAIT, RPCREPLY,
+                      NAMEREGISTER, NAMELOOKUP, EVENTSET, EVENTWAIT,
+                      SEMBLOCK, SEMWAKE, MUTEXBLOCK, MUTEXWAKE, POLLMSG,
+                      KERNEL_CALL_CODES};
 /*
  * @brief   Kernel Argument Structure
  * @details Holds all variables passed to kernel
@@ -50,6 +64,87 @@ typedef struct ReceiveMessage_
     int maxSize;
 }ReceiveMessage;
 
+/*
+ * Mailbox options set with mailboxControl()
+ * MB_OPT_INHERIT: a process that sends to the mailbox and then blocks
+ *                 receiving lends its priority to the mailbox owner
+ *                 until the owner sends to one of its mailboxes
+ * MB_OPT_SHARED:  up to MAILBOX_MEMBERS other processes may bind the
+ *                 mailbox and receive from it. Each message goes to the
+ *                 highest priority receiver blocked on the mailbox, the
+ *                 longest blocked among equals, or stays queued for the
+ *                 first receiver to ask. Members unbind before the owner
+ *                 can, and only the owner's receive with ANY sees it.
+ * MB_OPT_FORWARD: messages sent to the mailbox go instead to the other
+ *                 mailbox of the owner given as the value, preceded by a
+ *                 ForwardHeader naming the mailbox they were sent to;
+ *                 ANY stops forwarding
+ * MB_OPT_LIMIT:   most messages queued on the mailbox, 0 for no limit
+ *                 but the message pool
+ * MB_OPT_OVERLOAD: what a send to a mailbox at its limit does, one of
+ *                 enum overloadpolicies
+ */
+enum mailboxoptions {MB_OPT_INHERIT, MB_OPT_SHARED, MB_OPT_FORWARD, MB_OPT_LIMIT, MB_OPT_OVERLOAD};
+
+/*
+ * Overload policies of a mailbox with MB_OPT_LIMIT set. Messages a
+ * policy discards count as dropped in the mailbox statistics; the send
+ * itself succeeds.
+ * MB_OVERLOAD_BLOCK:       the sender blocks until the owner receives
+ *                          and there is room. Kernel posts (timers,
+ *                          interrupts, RPC requests) cannot block and
+ *                          are queued past the limit.
+ * MB_OVERLOAD_DROP_OLDEST: the oldest queued message is discarded
+ * MB_OVERLOAD_DROP_NEWEST: the message sent is discarded
+ * MB_OVERLOAD_LATEST:      a message replaces the queued one with the
+ *                          same key, its leading int, at any depth,
+ *                          keeping its place; without one the oldest is
+ *                          discarded at the limit
+ */
+enum overloadpolicies {MB_OVERLOAD_BLOCK, MB_OVERLOAD_DROP_OLDEST, MB_OVERLOAD_DROP_NEWEST, MB_OVERLOAD_LATEST};
+
+/*
+ * @brief   Mailbox Control Kernel Call Arguments
+ * @details Holds all variables passed to kernel
+ *          for when a mailbox option is set
+ */
+typedef struct MailBoxControl_
+{
+    int MB;
+    int option;
+    int value;
+}MailBoxControl;
+
+/*
+ * @brief   Timer Start Kernel Call Arguments
+ * @details Holds all variables passed to kernel
+ *          for when a software timer is started
+ */
+typedef struct TimerStart_
+{
+    int MB;
+    unsigned long ticks;
+    int periodic;
+}TimerStart;
+
+/* Latency buckets: bucket n counts samples of [2^n, 2^(n+1)) cycles */
+#define LATENCY_BUCKETS 24
+
+/*
+ * @brief   Latency Histogram
+ * @details Cycles from SVCHandler entry to its return for one
+ *          kernel call code, or from an interrupt request to its
+ *          handler for one interrupt class, log2 bucketed
+ */
+typedef struct LatencyHistogram_
+{
+    unsigned long buckets[LATENCY_BUCKETS];
+    unsigned long count;//number of samples recorded
+    unsigned long max;//longest sample in cycles
+    unsigned long min;//shortest sample in cycles
+    unsigned long total;//cycles of every sample recorded
+}LatencyHistogram;
+
 #ifndef GLOBAL_KERNELCALL
 #define GLOBAL_KERNELCALL
 
@@ -58,7 +153,36 @@ extern int unbind(int);
 extern int getid(void);
 extern int nice(int);
 extern void terminate(void);
+extern void exitProcess(int);
+extern int spawn(void (*)(void *), int, unsigned long, void *);
+extern int join(int);
+extern int channelBlock(struct Channel_ *, int);
+extern int channelWake(struct Channel_ *, int);
+extern int semaphoreBlock(struct Semaphore_ *);
+extern int semaphoreWake(struct Semaphore_ *);
+extern int mutexBlock(struct Mutex_ *);
+extern int mutexWake(struct Mutex_ *);
+extern int eventSet(int, unsigned long);
+extern unsigned long eventWait(unsigned long, int, int);
 extern int sendMessage(int, int, void *, int);
 extern int recvMessage(int, int*, void *, int);
+extern int pollMessage(int, int*, void *, int);
+extern int rpcCall(int, void *, int, void *, int);
+extern int rpcSend(int, void *, int);
+extern int rpcWait(int, void *, int);
+extern int rpcReply(int, void *, int);
+extern int registerName(const char *, int);
+extern int resolveName(const char *);
+extern int ps(struct ProcessStats_ *, int);
+extern int getLatency(int, LatencyHistogram *);
+extern int getIrqLatency(int, LatencyHistogram *);
+extern int getMailBoxStats(int, struct MailBoxStats_ *);
+extern int getPoolStats(struct PoolStats_ *);
+extern int getProfile(struct ProfileWindow_ *);
+extern int mailboxControl(int, int, int);
+extern int waitNextPeriod(void);
+extern int timerStart(int, unsigned long, int);
+extern int timerCancel(int);
+extern int schedulerMode(int);
 
 #endif
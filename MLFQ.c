@@ -0,0 +1,130 @@
+/*
+ * @file    MLFQ.c
+ * @brief   Contains the multilevel feedback queue mode: quantum
+ *          accounting, level changes and the periodic boost
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_MLFQ
+#include "MLFQ.h"
+#include "EDF.h"
+#include "SVC.h"
+#include "SYSTICK.h"
+#include "Utilities.h"
+
+/* Processes whose level MLFQ manages */
+#define MLFQ_MANAGED(pcb)   (mode == SCHED_MLFQ && !IS_EDF(pcb) && (pcb)->fixedPriority >= MLFQ_BOTTOM)
+
+PRIVATE int mode = SCHED_FIXED;
+PRIVATE unsigned long lastBoost = 0;
+
+/*
+ * @brief   Moves a managed process to a level, keeping any higher
+ *          priority lent to it
+ * @param   [in/out] PCB * process: process moved
+ *          [in] int level: its new base priority
+ */
+PRIVATE void mlfqMove(PCB * process, int level)
+{
+    process->basePriority = level;
+    process->quantumUsed = 0;
+    restorePriority(process);
+}
+
+/*
+ * @brief   Changes the scheduling mode
+ * @param   [in] int newMode: enum schedulermodes
+ * @return  int: the previous mode; -1 -> unknown mode
+ */
+int kernelSchedulerMode(int newMode)
+{
+    int previous = mode;
+    PCB * process;
+
+    if(newMode != SCHED_FIXED && newMode != SCHED_MLFQ)
+    {
+        return FAILURE;
+    }
+
+    mode = newMode;
+    lastBoost = sysTicks();
+    for(process = getProcessList(); process; process = process->nextProcess)
+    {
+        if(!IS_EDF(process) && process->fixedPriority >= MLFQ_BOTTOM)
+        {
+            mlfqMove(process, process->fixedPriority);
+        }
+    }
+    return previous;
+}
+
+/*
+ * @brief   Called from pendSV on every SysTick: boosts every managed
+ *          process when due, then charges the tick to the quantum of
+ *          the process SysTick interrupted
+ * @param   [in/out] PCB * interrupted: process that was running
+ *          [in] unsigned long now: current tick
+ * @return  int: TRUE if MLFQ has dealt with the interrupted process'
+ *               place in the queues; FALSE to rotate its queue as usual
+ */
+int mlfqTick(PCB * interrupted, unsigned long now)
+{
+    PCB * process;
+
+    if(mode != SCHED_MLFQ)
+    {
+        return FALSE;
+    }
+
+    if(now - lastBoost >= MLFQ_BOOST_TICKS)
+    {
+        lastBoost = now;
+        for(process = getProcessList(); process; process = process->nextProcess)
+        {
+            if(MLFQ_MANAGED(process))
+            {
+                mlfqMove(process, MLFQ_TOP);
+            }
+        }
+    }
+
+    if(!MLFQ_MANAGED(interrupted))
+    {
+        return FALSE;
+    }
+
+    /* Keeps the CPU until its quantum is used */
+    if(++interrupted->quantumUsed < MLFQ_QUANTUM(interrupted->basePriority))
+    {
+        return TRUE;
+    }
+
+    if(interrupted->basePriority > MLFQ_BOTTOM)
+    {
+        mlfqMove(interrupted, interrupted->basePriority - 1);
+        return TRUE;
+    }
+    interrupted->quantumUsed = 0;
+    return FALSE;
+}
+
+/*
+ * @brief   Called when a process blocks receiving: a managed process
+ *          that used less than half its quantum moves up a level
+ * @param   [in/out] PCB * process: process blocking
+ */
+void mlfqBlock(PCB * process)
+{
+    if(!MLFQ_MANAGED(process))
+    {
+        return;
+    }
+
+    if(2 * process->quantumUsed < MLFQ_QUANTUM(process->basePriority) &&
+       process->basePriority < MLFQ_TOP)
+    {
+        mlfqMove(process, process->basePriority + 1);
+    }
+    process->quantumUsed = 0;
+}
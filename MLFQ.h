@@ -0,0 +1,40 @@
+/*
+ * @file    MLFQ.h
+ * @brief   Multilevel feedback queue scheduling mode.
+ *          In SCHED_MLFQ mode the kernel sets the base priority of
+ *          every fixed priority process registered above LOW_PRIORITY:
+ *              - a process that runs for the whole quantum of its level
+ *                (MLFQ_QUANTUM ticks) moves down a level, to MLFQ_BOTTOM
+ *                at the lowest; there it is rotated as before
+ *              - a process that blocks in recvMessage() having used less
+ *                than half its quantum moves up a level
+ *              - every MLFQ_BOOST_TICKS all of them return to MLFQ_TOP
+ *          Level 0 is left to the idle process and EDF processes are
+ *          not affected. SCHED_FIXED (the default) is the fixed priority
+ *          rotation; switching back to it restores the priorities given
+ *          at registration or by nice().
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Process.h"
+
+enum schedulermodes {SCHED_FIXED, SCHED_MLFQ};
+
+/* Levels MLFQ moves processes between */
+#define MLFQ_TOP            (PRIORITY_LEVELS - 1)
+#define MLFQ_BOTTOM         1
+/* Ticks a process may run at a level before moving down; doubles per level down */
+#define MLFQ_QUANTUM(level) (1UL << (MLFQ_TOP - (level)))
+/* Ticks between priority boosts */
+#define MLFQ_BOOST_TICKS    100
+
+#ifndef GLOBAL_MLFQ
+#define GLOBAL_MLFQ
+
+extern int kernelSchedulerMode(int);
+extern int mlfqTick(PCB *, unsigned long);
+extern void mlfqBlock(PCB *);
+
+#endif /* GLOBAL_MLFQ */
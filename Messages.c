@@ -12,12 +12,19 @@
  */
 
 #define GLOBAL_MESSAGES
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "Messages.h"
 #include "SVC.h"
 #include "KernelCall.h"
 #include "Utilities.h"
-#include <stdio.h>
-#include <stdlib.h>
+#include "Trace.h"
+#include "DWT.h"
+#include "EDF.h"
+#include "SYSTICK.h"
+#include "MLFQ.h"
+#include "Names.h"
 
 #define  NEXT i+1
 #define  PREV i-1
@@ -34,35 +41,29 @@ static MailBox * freeMailBox;
 
 static ReceiveLog * receiveLogPool = NULL;
 
+/*Free counts and low-water marks of both pools*/
+static PoolStats poolStats;
+
 /*
  * @brief   Initializes the doubly linked list connecting unowned
  *          mailboxs allowing bind any in constant time
  */
 void initMailBoxList(void)
 {
-    int i = STARTING_INDEX;
-
-    mailboxList[i].index = i;
-
-    //initialize free to mailbox at starting index
-    freeMailBox = &mailboxList[i];
-
-    //first and last mailboxes must be initialized to point
-    //to eachother to give circular doubly linked list functionality
-
-    mailboxList[MAILBOX_MAX_INDEX].nextFree = &mailboxList[i];
-    mailboxList[i].prevFree = &mailboxList[MAILBOX_MAX_INDEX];
-    mailboxList[i].nextFree = &mailboxList[NEXT];
+    int i;
 
-    for(i; i<MAILBOX_MAX_INDEX;i++)
+    //first and last mailboxes point to each other to give
+    //circular doubly linked list functionality
+    for(i = STARTING_INDEX; i < MAILBOX_AMOUNT; i++)
     {
         mailboxList[i].index = i;
-        mailboxList[i].nextFree = &mailboxList[NEXT];
-        mailboxList[i].prevFree = &mailboxList[PREV];
+        mailboxList[i].forward = ANY;
+        mailboxList[i].nextFree = &mailboxList[(i < MAILBOX_MAX_INDEX) ? NEXT : STARTING_INDEX];
+        mailboxList[i].prevFree = &mailboxList[(i > STARTING_INDEX) ? PREV : MAILBOX_MAX_INDEX];
     }
 
-    mailboxList[i].index = i;
-    mailboxList[i].prevFree = &mailboxList[PREV];
+    //initialize free to mailbox at starting index
+    freeMailBox = &mailboxList[STARTING_INDEX];
 }
 
 /*
@@ -84,11 +85,12 @@ PCB * getOwnerPCB(int MB)
  */
 void addToPool(Message * newMsg)
 {
-    newMsg->from =NULL;
-    newMsg->size= NULL;
-    *(newMsg->contents)=NULL;
+    newMsg->from = 0;
+    newMsg->size = 0;
+    *(newMsg->contents) = NUL;
     newMsg->next = messagePool;
     messagePool = newMsg;
+    poolStats.freeMessages++;
 }
 
 /*
@@ -100,6 +102,14 @@ Message * retrieveFromPool(void)
     Message * newPtr = messagePool;
     // Fault protection
     messagePool = (newPtr) ? newPtr->next : NULL;
+    if(newPtr)
+    {
+        poolStats.freeMessages--;
+        if(poolStats.freeMessages < poolStats.minFreeMessages)
+        {
+            poolStats.minFreeMessages = poolStats.freeMessages;
+        }
+    }
     return newPtr;
 }
 
@@ -114,6 +124,7 @@ void initMessagePool(void)
     {
         addToPool(malloc(sizeof(Message)));
     }
+    poolStats.minFreeMessages = poolStats.freeMessages;
 }
 
 /*
@@ -123,9 +134,10 @@ void initMessagePool(void)
  */
 void addReceiveLog(ReceiveLog * newLog)
 {
-    newLog->from =NULL;
+    newLog->from = 0;
     newLog->next = receiveLogPool;
     receiveLogPool = newLog;
+    poolStats.freeReceiveLogs++;
 }
 
 /*
@@ -137,6 +149,14 @@ ReceiveLog * retrieveReceiveLog(void)
     ReceiveLog * newPtr = receiveLogPool;
     // Fault protection
     receiveLogPool = (newPtr) ? newPtr->next : NULL;
+    if(newPtr)
+    {
+        poolStats.freeReceiveLogs--;
+        if(poolStats.freeReceiveLogs < poolStats.minFreeReceiveLogs)
+        {
+            poolStats.minFreeReceiveLogs = poolStats.freeReceiveLogs;
+        }
+    }
     return newPtr;
 }
 
@@ -151,36 +171,297 @@ void initReceiveLogs(void)
     {
         addReceiveLog(malloc(sizeof(ReceiveLog)));
     }
+    poolStats.minFreeReceiveLogs = poolStats.freeReceiveLogs;
 }
 
+/*
+ * @brief   Appends a receive log to the receive-any list of the
+ *          process owning the mailbox the message was queued in
+ * @param   [in/out] PCB * owner: PCB of the mailbox owner
+ *          [in/out] ReceiveLog * newLog: log of the queued message
+ */
 void addReceiveLogToPCB(PCB* owner, ReceiveLog* newLog)
 {
-    if(owner->receiveAnyHead)
+    newLog->next = NULL;
+    newLog->prev = owner->receiveAnyTail;
+
+    if(owner->receiveAnyTail)
+    {
+        owner->receiveAnyTail->next = newLog;
+    }
+    else
     {
-        ReceiveLog * temp = owner->receiveAnyTail;
-        owner->receiveAnyTail = newLog;
-        owner->receiveAnyTail->next = NULL;
+        //first message queued for this process
+        owner->receiveAnyHead = newLog;
+    }
+    owner->receiveAnyTail = newLog;
+}
 
-        if (temp)
-        {
-            temp->next = owner->receiveAnyTail;
-            owner->receiveAnyTail->prev = temp;
-        }
-        else
-        {
-            owner->receiveAnyTail->prev = owner->receiveAnyHead;
-        }
+/*
+ * @brief   Unlinks a receive log from a process' receive-any list
+ * @param   [in/out] PCB * owner: PCB of the mailbox owner
+ *          [in/out] ReceiveLog * oldLog: log being removed
+ */
+void removeReceiveLogFromPCB(PCB* owner, ReceiveLog* oldLog)
+{
+    if(oldLog->prev)
+    {
+        oldLog->prev->next = oldLog->next;
     }
     else
     {
+        owner->receiveAnyHead = oldLog->next;
+    }
 
+    if(oldLog->next)
+    {
+        oldLog->next->prev = oldLog->prev;
+    }
+    else
+    {
+        owner->receiveAnyTail = oldLog->prev;
+    }
+}
+
+/*
+ * @brief   Adds a message and its receive log to the tail of a mailbox
+ * @param   [in/out] MailBox * mailbox: destination mailbox
+ *          [in/out] Message * newMessage: filled message structure
+ *          [in/out] ReceiveLog * newRecv: log of newMessage
+ */
+void enqueueMessage(MailBox * mailbox, Message * newMessage, ReceiveLog * newRecv)
+{
+    newMessage->next = NULL;
+    newRecv->myNext = NULL;
+
+    if(mailbox->head)
+    {
+        mailbox->tail->next = newMessage;
+        mailbox->newest->myNext = newRecv;
+    }
+    else
+    {
         //first message in mailbox
+        mailbox->head = newMessage;
+        mailbox->oldest = newRecv;
+    }
+    mailbox->tail = newMessage;
+    mailbox->newest = newRecv;
 
-        owner->receiveAnyHead = newLog;
-        owner->receiveAnyTail = NULL;
-        owner->receiveAnyHead->next = owner->receiveAnyTail;
-        owner->receiveAnyHead->prev = NULL;
+    mailbox->depth++;
+    mailbox->totalEnqueued++;
+    if(mailbox->depth > mailbox->peakDepth)
+    {
+        mailbox->peakDepth = mailbox->depth;
+    }
+}
+
+/*
+ * @brief   Removes the oldest message from a non-empty mailbox. The
+ *          caller is responsible for the receive log at mailbox->oldest,
+ *          which must be read before this call.
+ * @param   [in/out] MailBox * mailbox: mailbox to take from
+ * @return  Message *: the oldest message
+ */
+Message * dequeueMessage(MailBox * mailbox)
+{
+    Message * oldMessage = mailbox->head;
+
+    mailbox->head = oldMessage->next;
+    mailbox->oldest = mailbox->oldest->myNext;
+    mailbox->depth--;
+
+    return oldMessage;
+}
+
+/*
+ * @brief   Returns every message still queued in a mailbox, and its
+ *          receive log, to the pools
+ * @param   [in/out] MailBox * mailbox: mailbox being released
+ */
+void drainMailBox(MailBox * mailbox)
+{
+    ReceiveLog * oldLog;
+
+    while(mailbox->head)
+    {
+        oldLog = mailbox->oldest;
+        addToPool(dequeueMessage(mailbox));
+        removeReceiveLogFromPCB(mailbox->owner, oldLog);
+        addReceiveLog(oldLog);
+    }
+    mailbox->tail = NULL;
+    mailbox->newest = NULL;
+}
+
+/*
+ * @brief   Finds a process among the members of a shared mailbox
+ * @param   [in] MailBox * mailbox: mailbox of interest
+ *          [in] PCB * pcb: process to find, NULL for a free slot
+ * @return  int: index in members, FAILURE if not found
+ */
+PRIVATE int findMember(MailBox * mailbox, PCB * pcb)
+{
+    int i;
+
+    for(i = 0; i < MAILBOX_MEMBERS; i++)
+    {
+        if(mailbox->members[i] == pcb)
+        {
+            return i;
+        }
+    }
+    return FAILURE;
+}
+
+/*
+ * @brief   Counts the members bound to a shared mailbox
+ * @param   [in] MailBox * mailbox: mailbox of interest
+ * @return  int: number of members, the owner excluded
+ */
+PRIVATE int countMembers(MailBox * mailbox)
+{
+    int members = 0;
+    int i;
+
+    for(i = 0; i < MAILBOX_MEMBERS; i++)
+    {
+        members += (mailbox->members[i] != NULL);
+    }
+    return members;
+}
+
+/*
+ * @brief   Checks whether a process may receive from a mailbox
+ * @param   [in] MailBox * mailbox: mailbox of interest
+ *          [in] PCB * pcb: process asking
+ * @return  int: TRUE if it is the owner or a member
+ */
+PRIVATE int isReceiver(MailBox * mailbox, PCB * pcb)
+{
+    return (mailbox->owner == pcb) ||
+           (mailbox->shared && findMember(mailbox, pcb) != FAILURE);
+}
+
+/*
+ * @brief   Queues a receiver blocking on a shared mailbox behind those
+ *          of its priority or higher
+ * @param   [in/out] MailBox * mailbox: shared mailbox
+ *          [in/out] PCB * receiver: process blocking
+ */
+PRIVATE void addReceiver(MailBox * mailbox, PCB * receiver)
+{
+    PCB ** link = &mailbox->receivers;
+
+    while(*link && (*link)->priority >= receiver->priority)
+    {
+        link = &((*link)->nextReceiver);
+    }
+    receiver->nextReceiver = *link;
+    *link = receiver;
+}
+
+/*
+ * @brief   Discards the oldest message of a non-empty mailbox for its
+ *          overload policy
+ * @param   [in/out] MailBox * mailbox: mailbox at its limit
+ */
+PRIVATE void discardOldest(MailBox * mailbox)
+{
+    ReceiveLog * oldLog = mailbox->oldest;
+
+    addToPool(dequeueMessage(mailbox));
+    removeReceiveLogFromPCB(mailbox->owner, oldLog);
+    addReceiveLog(oldLog);
+    mailbox->dropped++;
+}
+
+/*
+ * @brief   Replaces the queued message with the key of a new one
+ *          (MB_OVERLOAD_LATEST), keeping its place in the queue
+ * @param   [in/out] MailBox * mailbox: mailbox sent to
+ *          [in] int fromMB: MB # reported to the receiver as the sender
+ *          [in] void* contents: new message, its leading int the key
+ *          [in] int size: amount of data measured in bytes
+ * @return  int: TRUE if a message was replaced
+ */
+PRIVATE int replaceLatest(MailBox * mailbox, int fromMB, void * contents, int size)
+{
+    Message * queued = mailbox->head;
+
+    if(size < (int)sizeof(int))
+    {
+        return FALSE;
+    }
+
+    while(queued && (queued->size < (int)sizeof(int) ||
+                     memcmp(queued->contents, contents, sizeof(int))))
+    {
+        queued = queued->next;
     }
+
+    if(queued)
+    {
+        queued->from = fromMB;
+        queued->size = size;
+        memcpy(queued->contents, contents, size);
+        mailbox->totalEnqueued++;
+        mailbox->dropped++;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/*
+ * @brief   Blocks the running process sending to a mailbox at its
+ *          limit (MB_OVERLOAD_BLOCK), behind senders of its priority
+ *          or higher; its message stays in its own memory until
+ *          admitSenders() queues it
+ * @param   [in/out] MailBox * mailbox: mailbox sent to
+ *          [in/out] PCB * sender: running process
+ *          [in] int fromMB: MB # of the sending process
+ *          [in] void* contents: data to be sent
+ *          [in] int size: amount of data measured in bytes
+ */
+PRIVATE void blockSender(MailBox * mailbox, PCB * sender, int fromMB, void * contents, int size)
+{
+    PCB ** link = &mailbox->senders;
+
+    TRACE(TRACE_BLOCK, sender->pid, mailbox->index);
+    removePCB();
+    sender->sendContents = contents;
+    sender->sendSize = size;
+    sender->sendFrom = fromMB;
+    sender->blockedAt = CYCLE_COUNT();
+    mlfqBlock(sender);
+
+    while(*link && (*link)->priority >= sender->priority)
+    {
+        link = &((*link)->nextSender);
+    }
+    sender->nextSender = *link;
+    *link = sender;
+}
+
+/*
+ * @brief   Wakes a blocked sender with the result of its send
+ * @param   [in/out] MailBox * mailbox: mailbox it was blocked on
+ *          [in/out] PCB * sender: first of mailbox->senders
+ *          [in] int result: SUCCESS or SEND_FAIL
+ */
+PRIVATE void wakeSender(MailBox * mailbox, PCB * sender, int result)
+{
+    mailbox->senders = sender->nextSender;
+    sender->nextSender = NULL;
+    sender->sendContents = NULL;
+    *(sender->returnValue) = result;
+    if(result == SUCCESS)
+    {
+        sender->messagesSent++;
+    }
+    sender->blockedCycles += CYCLE_COUNT() - sender->blockedAt;
+    addPCB(sender, sender->priority);
+    TRACE(TRACE_WAKE, sender->pid, mailbox->index);
 }
 
 int getOldestMessageMB(PCB* owner)
@@ -196,7 +477,7 @@ int getOldestMessageMB(PCB* owner)
 /*
  * @brief   Allow processes to bind to a mailbox
  * @param   int desiredMB: Mailbox that the process
- *          wants to bind to. If desiredMB == 16
+ *          wants to bind to. If desiredMB == ANY
  *          it will bind to the MB pointed to by
  *          freeMailBox
  * @return  Bind Fail = -4 or Mailbox Number that
@@ -205,7 +486,7 @@ int getOldestMessageMB(PCB* owner)
  * */
 int kernelBind(int desiredMB)
 {
-    if(!(STARTING_INDEX<=desiredMB&&desiredMB<=MAILBOX_AMOUNT))
+    if(desiredMB != ANY && !(STARTING_INDEX<=desiredMB&&desiredMB<MAILBOX_AMOUNT))
     {return BIND_FAIL;}
 
     if(desiredMB == ANY)
@@ -230,8 +511,16 @@ int kernelBind(int desiredMB)
     else
     {
         // BIND SPECIFIC
+        PCB * runningPCB = (struct ProcessControlBlock_*)getRunningPCB();
+        int member = findMember(&mailboxList[desiredMB], NULL);
 
-        if(!(mailboxList[desiredMB].owner))
+        if(mailboxList[desiredMB].shared && member != FAILURE &&
+           !isReceiver(&mailboxList[desiredMB], runningPCB))
+        {
+            // JOIN SHARED
+            mailboxList[desiredMB].members[member] = runningPCB;
+        }
+        else if(!(mailboxList[desiredMB].owner))
         {
             mailboxList[desiredMB].owner = (struct ProcessControlBlock_*)getRunningPCB();
             mailboxList[desiredMB].prevFree->nextFree = mailboxList[desiredMB].nextFree;
@@ -248,9 +537,44 @@ int kernelBind(int desiredMB)
             desiredMB = BIND_FAIL;
         }
     }
+
+    if(desiredMB != BIND_FAIL)
+    {
+        TRACE(TRACE_BIND, getRunningPCB()->pid, desiredMB);
+    }
     return desiredMB;
 }
 
+/*
+ * @brief   Returns a mailbox to the free list: its messages go back to
+ *          the pools, its blocked senders fail and its names are removed
+ * @param   [in/out] MailBox * mailbox: mailbox its owner releases
+ */
+PRIVATE void releaseMailBox(MailBox * mailbox)
+{
+    drainMailBox(mailbox);
+    while(mailbox->senders)
+    {
+        mailbox->sendsRejected++;
+        wakeSender(mailbox, mailbox->senders, SEND_FAIL);
+    }
+    kernelNameRelease(mailbox->index);
+    mailbox->owner = NULL;
+    mailbox->inherit = FALSE;
+    mailbox->shared = FALSE;
+    mailbox->forward = ANY;
+    mailbox->limit = 0;
+    mailbox->overload = MB_OVERLOAD_BLOCK;
+
+    //insert ahead of the free list's head, behind its tail
+    mailbox->nextFree = (freeMailBox)? freeMailBox : mailbox;
+    mailbox->prevFree = (freeMailBox)? freeMailBox->prevFree : mailbox;
+
+    freeMailBox = mailbox;
+    freeMailBox->nextFree->prevFree = mailbox;
+    freeMailBox->prevFree->nextFree = mailbox;
+}
+
 /*
  * @brief   Allow processes to unbind from a mailbox
  * @param   int releasedMB: Mailbox number the process
@@ -260,15 +584,24 @@ int kernelBind(int desiredMB)
  * */
 int kernelUnbind(int releaseMB)
 {
-    if(mailboxList[releaseMB].owner == getRunningPCB()||!(STARTING_INDEX<=releaseMB&&releaseMB<=MAILBOX_AMOUNT))
-    {
-        mailboxList[releaseMB].owner = NULL;
+    if(!(STARTING_INDEX<=releaseMB&&releaseMB<MAILBOX_AMOUNT))
+    {return UNBIND_FAIL;}
 
-        mailboxList[releaseMB].nextFree = (freeMailBox)? freeMailBox : &mailboxList[releaseMB];
-        mailboxList[releaseMB].prevFree = (freeMailBox)? freeMailBox->prevFree : &mailboxList[releaseMB];
+    int member = findMember(&mailboxList[releaseMB], getRunningPCB());
 
-        freeMailBox = &mailboxList[releaseMB];
-        freeMailBox->nextFree->prevFree =  &mailboxList[releaseMB];
+    if(mailboxList[releaseMB].shared && member != FAILURE)
+    {
+        mailboxList[releaseMB].members[member] = NULL;
+        TRACE(TRACE_UNBIND, getRunningPCB()->pid, releaseMB);
+        return SUCCESS;
+    }
+
+    //the owner of a shared mailbox releases it after its members
+    if(mailboxList[releaseMB].owner == getRunningPCB() &&
+       !countMembers(&mailboxList[releaseMB]))
+    {
+        releaseMailBox(&mailboxList[releaseMB]);
+        TRACE(TRACE_UNBIND, getRunningPCB()->pid, releaseMB);
 
         return SUCCESS;
     }
@@ -276,102 +609,337 @@ int kernelUnbind(int releaseMB)
 }
 
 /*
- * @brief   Adds message to a mailbox, if destination process is blocked; it transfers message
- *          and unblocks
+ * @brief   Makes the first member of a shared mailbox its owner, with
+ *          the receive logs of the messages still queued
+ * @param   [in/out] MailBox * mailbox: shared mailbox whose owner exits
+ *          [in] int member: index in members of the new owner
+ */
+PRIVATE void handOverMailBox(MailBox * mailbox, int member)
+{
+    PCB * newOwner = mailbox->members[member];
+    ReceiveLog * log;
+
+    for(log = mailbox->oldest; log; log = log->myNext)
+    {
+        removeReceiveLogFromPCB(mailbox->owner, log);
+        addReceiveLogToPCB(newOwner, log);
+    }
+    mailbox->members[member] = NULL;
+    mailbox->owner = newOwner;
+}
+
+/*
+ * @brief   Unbinds every mailbox of an exiting process. It leaves the
+ *          shared mailboxes it is a member of; one it owns passes to
+ *          its first remaining member, the rest are released as by
+ *          kernelUnbind().
+ * @param   [in] PCB * pcb: process exiting, no longer RUNNING
+ */
+void kernelReleaseMailBoxes(PCB * pcb)
+{
+    MailBox * mailbox;
+    int member;
+    int MB;
+
+    for(MB = STARTING_INDEX; MB < MAILBOX_AMOUNT; MB++)
+    {
+        mailbox = &mailboxList[MB];
+        if(mailbox->shared && (member = findMember(mailbox, pcb)) != FAILURE)
+        {
+            mailbox->members[member] = NULL;
+            TRACE(TRACE_UNBIND, pcb->pid, MB);
+        }
+        else if(mailbox->owner == pcb)
+        {
+            if(mailbox->shared && countMembers(mailbox))
+            {
+                member = 0;
+                while(!mailbox->members[member])
+                {
+                    member++;
+                }
+                handOverMailBox(mailbox, member);
+            }
+            else
+            {
+                releaseMailBox(mailbox);
+            }
+            TRACE(TRACE_UNBIND, pcb->pid, MB);
+        }
+    }
+}
+
+/*
+ * @brief   Adds message to a valid, bound mailbox, if a receiver is blocked on it;
+ *          it transfers message and unblocks. A shared mailbox hands it to
+ *          the first receiver in its blocked list. A mailbox at its limit
+ *          applies its overload policy.
  * @param   [in] int destinationMB: MB # of the destination process
- *          [in] int fromMB: MB # of the sending process
+ *          [in] int fromMB: MB # reported to the receiver as the sender
  *          [in] void* contents: data to be sent
  *          [in] int size: amount of data measured in bytes
- * @return  int: 1->success, -1->failure
+ *          [in/out] PCB * sender: running process sending, which may
+ *                   block; NULL for a kernel post
+ * @return  int: 1->success, -2->no free message or receive log
  */
-int kernelSend(int destinationMB, int fromMB, void * contents, int size)
+PRIVATE int deliverMessage(int destinationMB, int fromMB, void * contents, int size, PCB * sender)
 {
+   MailBox * mailbox = &mailboxList[destinationMB];
 
-   PCB * runningPCB = (struct ProcessControlBlock_*) getRunningPCB();
+   PCB * receiver = mailboxList[destinationMB].owner;
 
-   //check the validity of arguments
-   if((mailboxList[fromMB].owner != runningPCB)||
-      (!(mailboxList[destinationMB].owner))||
-      (MESSAGE_SYS_LIMIT<size))
-   {return SEND_FAIL;}
+   if(mailboxList[destinationMB].receivers)
+   {
+       receiver = mailboxList[destinationMB].receivers;
+       mailboxList[destinationMB].receivers = receiver->nextReceiver;
+       receiver->nextReceiver = NULL;
+   }
+   //otherwise check if the owner is blocked on this mailbox
+   else if(!(receiver->contents &&
+             (receiver->receiveMB == ANY || receiver->receiveMB == destinationMB)))
+   {
+       receiver = NULL;
+   }
 
-   //check if the destination process is blocked
-   if(mailboxList[destinationMB].owner->contents)
+   if(receiver)
    {
-       /* If the owner's PCB is blocked*/
+       /* If the receiver's PCB is blocked*/
 
-     *(mailboxList[destinationMB].owner->from) = fromMB;
-     int copySize = (mailboxList[destinationMB].owner->size< size)?
-                     mailboxList[destinationMB].owner->size :
+     *(receiver->from) = fromMB;
+     int copySize = (receiver->size< size)?
+                     receiver->size :
                      size;
-      memcpy(mailboxList[destinationMB].owner->contents, contents, copySize);
-      addPCB(mailboxList[destinationMB].owner, mailboxList[destinationMB].owner->priority);
-      *(mailboxList[destinationMB].owner->returnValue) = copySize;
-      mailboxList[destinationMB].owner->contents = NULL;
+      memcpy(receiver->contents, contents, copySize);
+      //a message wakes an EDF process to a new job
+      if(IS_EDF(receiver))
+      {
+          edfRelease(receiver, sysTicks());
+      }
+      addPCB(receiver, receiver->priority);
+      *(receiver->returnValue) = copySize;
+      receiver->contents = NULL;
+      receiver->messagesReceived++;
+      receiver->blockedCycles +=
+              CYCLE_COUNT() - receiver->blockedAt;
+      mailboxList[destinationMB].totalEnqueued++;
+      TRACE(TRACE_WAKE, receiver->pid, destinationMB);
 
    }
    else
    {
+       if(mailbox->overload == MB_OVERLOAD_LATEST &&
+          replaceLatest(mailbox, fromMB, contents, size))
+       {
+           return SUCCESS;
+       }
+
+       if(mailbox->limit && mailbox->depth >= mailbox->limit)
+       {
+           switch(mailbox->overload)
+           {
+           case MB_OVERLOAD_BLOCK:
+               //a receiver of the mailbox would wait on itself
+               if(sender && isReceiver(mailbox, sender))
+               {
+                   mailbox->sendsRejected++;
+                   return SEND_FAIL;
+               }
+               if(sender)
+               {
+                   blockSender(mailbox, sender, fromMB, contents, size);
+                   return SUCCESS;
+               }
+               //kernel posts are queued past the limit
+           break;
+           case MB_OVERLOAD_DROP_NEWEST:
+               mailbox->dropped++;
+               return SUCCESS;
+           default:
+               discardOldest(mailbox);
+           }
+       }
+
        //if not blocked, fill a message structure from the
        //message pool and put it in the mailbox
-       ReceiveLog * newRecv = retrieveReceiveLog();
        Message * newMessage = retrieveFromPool();
+       ReceiveLog * newRecv = (newMessage) ? retrieveReceiveLog() : NULL;
 
-       if(newMessage)
+       if(newRecv)
        {
            newRecv->from = destinationMB;
            newMessage->from = fromMB;
            newMessage->size = size;
            memcpy(newMessage->contents, contents, size);
-           if(mailboxList[destinationMB].head)
+           enqueueMessage(&mailboxList[destinationMB], newMessage, newRecv);
+           addReceiveLogToPCB(mailboxList[destinationMB].owner, newRecv);
+       }
+       else
+       {
+           if(newMessage)
            {
-               ReceiveLog * tempLog = mailboxList[destinationMB].newest;
-               mailboxList[destinationMB].newest= newRecv;
-               mailboxList[destinationMB].newest->myNext = NULL;
-               if (tempLog)
-               {
-                    tempLog->myNext = mailboxList[destinationMB].newest;
-               }
-
-               Message * temp = mailboxList[destinationMB].tail;
-               mailboxList[destinationMB].tail = newMessage;
-               mailboxList[destinationMB].tail->next = NULL;
-               if(temp)
-               {
-                   temp->next = mailboxList[destinationMB].tail;
-               }
+               addToPool(newMessage);
            }
-           else
-           {
+           mailboxList[destinationMB].sendsRejected++;
+           return SEND_FAIL;
+       }
+
+   }
+   return SUCCESS;
+}
 
-               //first message in mailbox
+/*
+ * @brief   Queues the messages of blocked senders while the mailbox has
+ *          room, waking each sender
+ * @param   [in/out] MailBox * mailbox: mailbox received from or
+ *          reconfigured
+ */
+PRIVATE void admitSenders(MailBox * mailbox)
+{
+    PCB * sender;
 
-               mailboxList[destinationMB].oldest = newRecv;
-               mailboxList[destinationMB].oldest->myNext = mailboxList[destinationMB].newest;
+    while(mailbox->senders &&
+          !(mailbox->limit && mailbox->depth >= mailbox->limit &&
+            mailbox->overload == MB_OVERLOAD_BLOCK))
+    {
+        sender = mailbox->senders;
+        wakeSender(mailbox, sender,
+                   deliverMessage(mailbox->index, sender->sendFrom, sender->sendContents,
+                                  sender->sendSize, NULL));
+    }
+}
 
-               mailboxList[destinationMB].head = newMessage;
-               mailboxList[destinationMB].tail=NULL;
-               mailboxList[destinationMB].head->next = mailboxList[destinationMB].tail;
-           }
-           addReceiveLogToPCB(runningPCB, newRecv);
+/*
+ * @brief   Delivers a message to its mailbox, or with a ForwardHeader to
+ *          the mailbox it forwards to (MB_OPT_FORWARD)
+ * @param   [in] int destinationMB: MB # the message is sent to
+ *          [in] int fromMB: MB # reported to the receiver as the sender
+ *          [in] void* contents: data to be sent
+ *          [in] int size: amount of data measured in bytes
+ *          [in/out] PCB * sender: running process sending, NULL for a
+ *                   kernel post
+ * @return  int: 1->success, -2->no free message or receive log, too
+ *               large to forward or nowhere to forward to
+ */
+PRIVATE int routeMessage(int destinationMB, int fromMB, void * contents, int size, PCB * sender)
+{
+    char forwarded[MESSAGE_SYS_LIMIT];
+    ForwardHeader header;
+    int forwardMB = mailboxList[destinationMB].forward;
+
+    if(forwardMB == ANY)
+    {
+        return deliverMessage(destinationMB, fromMB, contents, size, sender);
+    }
+
+    //the forwarding mailbox outlives the one it forwards to
+    if(FORWARD_LIMIT < size || !(mailboxList[forwardMB].owner))
+    {
+        mailboxList[destinationMB].sendsRejected++;
+        return SEND_FAIL;
+    }
+
+    header.toMB = destinationMB;
+    memcpy(forwarded, &header, sizeof(ForwardHeader));
+    memcpy(&forwarded[sizeof(ForwardHeader)], contents, size);
+    mailboxList[destinationMB].totalEnqueued++;
+    //a forwarded message is copied, so its sender cannot block on it
+    return deliverMessage(forwardMB, fromMB, forwarded, sizeof(ForwardHeader) + size, NULL);
+}
+
+/*
+ * @brief   Adds message to a mailbox, if destination process is blocked; it transfers message
+ *          and unblocks. The sender blocks if the mailbox is at its
+ *          limit with MB_OVERLOAD_BLOCK, until there is room.
+ * @param   [in] int destinationMB: MB # of the destination process
+ *          [in] int fromMB: MB # of the sending process
+ *          [in] void* contents: data to be sent
+ *          [in] int size: amount of data measured in bytes
+ *          [out] int * returnValue: receives 1->success, -2->failure,
+ *                now or when a blocked send completes
+ * @return  int: TRUE if the sender blocked
+ */
+int kernelSend(int destinationMB, int fromMB, void * contents, int size, int * returnValue)
+{
+
+   PCB * runningPCB = (struct ProcessControlBlock_*) getRunningPCB();
+
+   *returnValue = SEND_FAIL;
+   if(!(STARTING_INDEX<=destinationMB&&destinationMB<MAILBOX_AMOUNT)||
+      !(STARTING_INDEX<=fromMB&&fromMB<MAILBOX_AMOUNT))
+   {return FALSE;}
+
+   //check the validity of arguments; a blocked send is marked by its contents
+   if((mailboxList[fromMB].owner != runningPCB)||
+      (!(mailboxList[destinationMB].owner))||
+      (!contents)||
+      (MESSAGE_SYS_LIMIT<size))
+   {
+       mailboxList[destinationMB].sendsRejected++;
+       return FALSE;
+   }
+
+   //a send to an inheriting server is a request the sender may block awaiting the reply of
+   if(mailboxList[destinationMB].inherit)
+   {
+       runningPCB->waitingOn = mailboxList[destinationMB].owner;
+   }
+
+   if(routeMessage(destinationMB, fromMB, contents, size, runningPCB) != SUCCESS)
+   {
+       return FALSE;
+   }
+   *returnValue = SUCCESS;
+
+   //a reply to a client waiting on this process ends any priority it lent
+   if(mailboxList[destinationMB].owner->waitingOn == runningPCB)
+   {
+       mailboxList[destinationMB].owner->waitingOn = NULL;
+       if(runningPCB->priority != runningPCB->basePriority)
+       {
+           restorePriority(runningPCB);
        }
-       else{ return SEND_FAIL;}
+   }
 
+   if(runningPCB->sendContents)
+   {
+       runningPCB->returnValue = returnValue;
+       return TRUE;
    }
-   return SUCCESS;
+   runningPCB->messagesSent++;
+   return FALSE;
+}
+
+/*
+ * @brief   Adds a message from the kernel itself (e.g. a timer) to a
+ *          mailbox; there is no sending process to check or charge
+ * @param   [in] int destinationMB: MB # of the destination process
+ *          [in] int fromMB: MB # reported to the receiver as the sender
+ *          [in] void* contents: data to be sent
+ *          [in] int size: amount of data measured in bytes
+ * @return  int: 1->success, -2->failure
+ */
+int kernelPost(int destinationMB, int fromMB, void * contents, int size)
+{
+   if(!(STARTING_INDEX<=destinationMB&&destinationMB<MAILBOX_AMOUNT) ||
+      !(mailboxList[destinationMB].owner) || (MESSAGE_SYS_LIMIT<size))
+   {return SEND_FAIL;}
+
+   return routeMessage(destinationMB, fromMB, contents, size, NULL);
 }
 
 /*
- * @brief   Take message from a mailbox, blocks if mailbox is empty
- *          and unblocks
+ * @brief   Take message from a mailbox, blocks if mailbox is empty.
+ *          When blocking, RUNNING is advanced and the context switch
+ *          is completed by SVCHandler
  * @param   [in] int bindedMB: MB # of the receiving process
  *          [out] int* returnMB: MB # of the process that sent the message
  *          [in/out] void* contents: address where data is stored
  *          [in/out] int* maxSize: [in]maximum amount of bytes the process will take
  *                                 [out] amount of bytes that were copied
- * @return  int: -1->failure, 1->success
+ *          [in] int block: FALSE to return RECV_EMPTY rather than block
+ * @return  int: -3->failure, -7->nothing to receive without blocking, 1->success
  */
-int kernelReceive(int bindedMB, int* returnMB, void * contents, int * maxSize)
+int kernelReceive(int bindedMB, int* returnMB, void * contents, int * maxSize, int block)
 {
     PCB * runningPCB = (struct ProcessControlBlock_*) getRunningPCB();
 
@@ -382,8 +950,8 @@ int kernelReceive(int bindedMB, int* returnMB, void * contents, int * maxSize)
 
     if(bindedMB!=ANY)
     {
-        if ((mailboxList[bindedMB].owner != runningPCB)
-                || !(STARTING_INDEX <= bindedMB && bindedMB < MAILBOX_AMOUNT)
+        if (!(STARTING_INDEX <= bindedMB && bindedMB < MAILBOX_AMOUNT)
+                || !isReceiver(&mailboxList[bindedMB], runningPCB)
                 || (MESSAGE_SYS_LIMIT < *maxSize))
         {return RECV_FAIL;}
 
@@ -392,59 +960,157 @@ int kernelReceive(int bindedMB, int* returnMB, void * contents, int * maxSize)
         {
             // Mailbox contains at least one message
 
-            if( runningPCB->receiveAnyHead == mailboxList[bindedMB].oldest)
-            {
-                runningPCB->receiveAnyHead = runningPCB->receiveAnyHead->next;
-
-                if(runningPCB->receiveAnyHead)
-                {
-                    runningPCB->receiveAnyHead->prev = NULL;
-                }
-            }
-            else if(runningPCB->receiveAnyTail == mailboxList[bindedMB].oldest)
-            {
-                if(runningPCB->receiveAnyTail->prev == runningPCB->receiveAnyHead)
-                {
-                    runningPCB->receiveAnyTail=NULL;
-                }
-                else
-                {
-                    runningPCB->receiveAnyTail = runningPCB->receiveAnyTail->prev;
-                    runningPCB->receiveAnyTail->next=NULL;
-                }
-
-            }
-            else
-            {
-                mailboxList[bindedMB].oldest->next->prev =mailboxList[bindedMB].oldest->prev;
-                mailboxList[bindedMB].oldest->prev->next = mailboxList[bindedMB].oldest->next;
-            }
+            ReceiveLog * oldLog = mailboxList[bindedMB].oldest;
+            Message * temp = dequeueMessage(&mailboxList[bindedMB]);
 
-            mailboxList[bindedMB].oldest = mailboxList[bindedMB].oldest->myNext;
+            removeReceiveLogFromPCB(mailboxList[bindedMB].owner, oldLog);
+            addReceiveLog(oldLog);
 
-            *returnMB = mailboxList[bindedMB].head->from;
+            *returnMB = temp->from;
 
             int copySize =
-                    (mailboxList[bindedMB].head->size < *maxSize) ?
-                            mailboxList[bindedMB].head->size : *maxSize;
+                    (temp->size < *maxSize) ?
+                            temp->size : *maxSize;
 
-            memcpy(contents, mailboxList[bindedMB].head->contents, copySize);
-            Message * temp = mailboxList[bindedMB].head;
-            mailboxList[bindedMB].head = mailboxList[bindedMB].head->next;
+            memcpy(contents, temp->contents, copySize);
+            *maxSize = copySize;
             addToPool(temp);
+            runningPCB->messagesReceived++;
+            admitSenders(&mailboxList[bindedMB]);
             return SUCCESS;
         }
     }
+    if(!block)
+    {
+        return RECV_EMPTY;
+    }
     // BLOCK
+    TRACE(TRACE_BLOCK, runningPCB->pid, bindedMB);
+    //blocking completes an EDF job
+    if(IS_EDF(runningPCB))
+    {
+        edfCheckDeadline(runningPCB);
+    }
     removePCB();
     runningPCB->from = returnMB;
     runningPCB->contents = contents;
+    runningPCB->receiveMB = bindedMB;
+    if(bindedMB != ANY && mailboxList[bindedMB].shared)
+    {
+        addReceiver(&mailboxList[bindedMB], runningPCB);
+    }
     runningPCB->size = *maxSize;
     runningPCB->returnValue = maxSize;
-    runningPCB->sp = get_PSP();
-    runningPCB = (struct ProcessControlBlock_*) getRunningPCB();
-    set_PSP(runningPCB->sp);
+    runningPCB->blockedAt = CYCLE_COUNT();
+    mlfqBlock(runningPCB);
+
+    //lend this process' priority to the server it waits on
+    if(runningPCB->waitingOn)
+    {
+        inheritPriority(runningPCB->waitingOn, runningPCB->priority);
+    }
+
+    return SUCCESS;
+}
+
+/*
+ * @brief   Copies the occupancy statistics of a mailbox
+ * @param   [in] int MB: mailbox of interest
+ *          [out] MailBoxStats * stats: destination
+ * @return  int: 1->success, -1->invalid mailbox
+ */
+int kernelMailBoxStats(int MB, MailBoxStats * stats)
+{
+    if(!(STARTING_INDEX<=MB&&MB<MAILBOX_AMOUNT))
+    {return FAILURE;}
 
+    stats->owner = (mailboxList[MB].owner) ? (int)mailboxList[MB].owner->pid : FAILURE;
+    stats->depth = mailboxList[MB].depth;
+    stats->peakDepth = mailboxList[MB].peakDepth;
+    stats->totalEnqueued = mailboxList[MB].totalEnqueued;
+    stats->sendsRejected = mailboxList[MB].sendsRejected;
+    stats->members = countMembers(&mailboxList[MB]);
+    stats->dropped = mailboxList[MB].dropped;
+    stats->limit = mailboxList[MB].limit;
+    return SUCCESS;
+}
+
+/*
+ * @brief   Copies the message and receive log pool counters
+ * @param   [out] PoolStats * stats: destination
+ * @return  int: 1->success
+ */
+int kernelPoolStats(PoolStats * stats)
+{
+    *stats = poolStats;
     return SUCCESS;
 }
 
+/*
+ * @brief   Checks whether a mailbox lends its owner the priority of
+ *          clients awaiting its reply (MB_OPT_INHERIT)
+ * @param   [in] int MB: mailbox of interest
+ * @return  int: TRUE if bound with MB_OPT_INHERIT set
+ */
+int mailboxInherits(int MB)
+{
+    return (STARTING_INDEX<=MB&&MB<MAILBOX_AMOUNT) &&
+           mailboxList[MB].owner && mailboxList[MB].inherit;
+}
+
+/*
+ * @brief   Sets an option of a mailbox owned by the caller
+ * @param   [in] int MB: mailbox to configure
+ *          [in] int option: one of enum mailboxoptions
+ *          [in] int value: new value of the option
+ * @return  int: 1->success, -1->not the owner or unknown option
+ */
+int kernelMailBoxControl(int MB, int option, int value)
+{
+    if(!(STARTING_INDEX<=MB&&MB<MAILBOX_AMOUNT)||
+       (mailboxList[MB].owner != getRunningPCB()))
+    {return FAILURE;}
+
+    switch(option)
+    {
+    case MB_OPT_INHERIT:
+        mailboxList[MB].inherit = (value) ? TRUE : FALSE;
+    break;
+    case MB_OPT_SHARED:
+        //members must unbind before sharing ends
+        if(!value && countMembers(&mailboxList[MB]))
+        {
+            return FAILURE;
+        }
+        mailboxList[MB].shared = (value) ? TRUE : FALSE;
+    break;
+    case MB_OPT_FORWARD:
+        //only to another bound mailbox of the owner
+        if(value != ANY && (!(STARTING_INDEX<=value&&value<MAILBOX_AMOUNT) ||
+                            value == MB || mailboxList[value].owner != getRunningPCB()))
+        {
+            return FAILURE;
+        }
+        mailboxList[MB].forward = value;
+    break;
+    case MB_OPT_LIMIT:
+        if(value < 0)
+        {
+            return FAILURE;
+        }
+        mailboxList[MB].limit = value;
+    break;
+    case MB_OPT_OVERLOAD:
+        if(value < MB_OVERLOAD_BLOCK || value > MB_OVERLOAD_LATEST)
+        {
+            return FAILURE;
+        }
+        mailboxList[MB].overload = value;
+    break;
+    default:
+        return FAILURE;
+    }
+    //a raised limit or another policy may make room for blocked senders
+    admitSenders(&mailboxList[MB]);
+    return SUCCESS;
+}
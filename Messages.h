@@ -11,9 +11,14 @@
 #include "Process.h"
 #include "Utilities.h"
 
-/* Maximum number of message queues allowed */
-#define MAILBOX_AMOUNT 16
-#define MAILBOX_MAX_INDEX MAILBOX_AMOUNT - 1
+/* Maximum number of message queues allowed, overridable at build time
+ * (e.g. --define=MAILBOX_AMOUNT=256); trace events record up to 255 */
+#ifndef MAILBOX_AMOUNT
+#define MAILBOX_AMOUNT 128
+#endif
+#define MAILBOX_MAX_INDEX (MAILBOX_AMOUNT - 1)
+/* Processes besides the owner that may bind a shared mailbox */
+#define MAILBOX_MEMBERS 8
 
 
 /* Structure containing information about messages */
@@ -67,27 +72,114 @@ typedef struct MailBox_
 
     ReceiveLog * newest;
 
+    /* Occupancy statistics */
+    int depth;
+    int peakDepth;
+    unsigned long totalEnqueued;
+    unsigned long sendsRejected;
+
+    /* TRUE if senders waiting on a reply lend their priority to the owner */
+    int inherit;
+
+    /* TRUE if other processes may bind the mailbox to receive (MB_OPT_SHARED) */
+    int shared;
+    /* Processes other than the owner bound to a shared mailbox */
+    struct ProcessControlBlock_ * members[MAILBOX_MEMBERS];
+    /* Receivers blocked on a shared mailbox, highest priority first,
+     * linked through nextReceiver */
+    struct ProcessControlBlock_ * receivers;
+
+    /* Mailbox messages are redirected to (MB_OPT_FORWARD), ANY if none */
+    int forward;
+
+    /* Most messages queued (MB_OPT_LIMIT), 0 if unlimited, and what a
+     * send beyond it does (MB_OPT_OVERLOAD) */
+    int limit;
+    int overload;
+    /* Messages discarded by the overload policy */
+    unsigned long dropped;
+    /* Senders blocked on the limit, highest priority first, linked
+     * through nextSender */
+    struct ProcessControlBlock_ * senders;
+
 }MailBox;
 
+/* Precedes a message redirected by MB_OPT_FORWARD */
+typedef struct ForwardHeader_
+{
+    /* Mailbox the message was sent to */
+    int toMB;
+
+}ForwardHeader;
+
+/* Largest message that can be sent to a forwarding mailbox */
+#define FORWARD_LIMIT (MESSAGE_SYS_LIMIT - (int)sizeof(ForwardHeader))
+
+/* Occupancy statistics of one mailbox, returned by getMailBoxStats() */
+typedef struct MailBoxStats_
+{
+    /* pid of the owner, -1 if unbound */
+    int owner;
+    /* Messages currently queued and the most ever queued */
+    int depth;
+    int peakDepth;
+    /* Messages accepted, queued or handed directly to a blocked owner */
+    unsigned long totalEnqueued;
+    /* Sends to this mailbox that failed */
+    unsigned long sendsRejected;
+    /* Processes besides the owner bound to it (MB_OPT_SHARED) */
+    int members;
+    /* Messages discarded by its overload policy, and its limit */
+    unsigned long dropped;
+    int limit;
+
+}MailBoxStats;
+
+/* Free structure counts and their lifetime minimums, returned by getPoolStats() */
+typedef struct PoolStats_
+{
+    int freeMessages;
+    int minFreeMessages;
+    int freeReceiveLogs;
+    int minFreeReceiveLogs;
+
+}PoolStats;
+
 #ifndef GLOBAL_MESSAGES
 #define GLOBAL_MESSAGES
 
 extern int kernelBind(int);
 extern int kernelUnbind(int);
-extern int kernelSend(int,int,void *, int);
-extern int kernelReceive(int,int*,void*,int*);
+extern void kernelReleaseMailBoxes(PCB *);
+extern int kernelSend(int,int,void *, int, int *);
+extern int kernelPost(int,int,void *, int);
+extern int kernelReceive(int,int*,void*,int*,int);
 extern void initMessagePool(void);
 extern void initMailBoxList(void);
 extern PCB * getOwnerPCB(int);
 extern void initReceiveLogs(void);
+extern int kernelMailBoxStats(int, MailBoxStats *);
+extern int kernelPoolStats(PoolStats *);
+extern int kernelMailBoxControl(int, int, int);
+extern int mailboxInherits(int);
+extern void addToPool(Message *);
+extern Message * retrieveFromPool(void);
 
 #else
 
-int kernelSend(int,int,void *, int);
-int kernelReceive(int,int*,void*,int*);
+int kernelSend(int,int,void *, int, int *);
+int kernelReceive(int,int*,void*,int*,int);
 void addToPool(Message *);
 Message * retrieveFromPool(void);
 void addReceiveLog(ReceiveLog *);
 ReceiveLog * retrieveReceiveLog(void);
+void addReceiveLogToPCB(PCB *, ReceiveLog *);
+void removeReceiveLogFromPCB(PCB *, ReceiveLog *);
+void enqueueMessage(MailBox *, Message *, ReceiveLog *);
+Message * dequeueMessage(MailBox *);
+void drainMailBox(MailBox *);
+int kernelMailBoxStats(int, MailBoxStats *);
+int kernelPoolStats(PoolStats *);
+int kernelMailBoxControl(int, int, int);
 
 #endif /* GLOBAL_SVC */
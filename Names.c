@@ -0,0 +1,198 @@
+/*
+ * @file    Names.c
+ * @brief   Contains the name hash table, the thread mode cached lookup
+ *          and the kernel side of registering and resolving names
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_NAMES
+#include <string.h>
+#include "Names.h"
+#include "KernelCall.h"
+#include "Messages.h"
+#include "Utilities.h"
+
+#define FNV_OFFSET  2166136261UL
+#define FNV_PRIME   16777619UL
+
+PRIVATE Name nameList[NAME_AMOUNT];
+PRIVATE Name * freeNames = NULL;
+PRIVATE Name * nameTable[NAME_BUCKETS];
+PRIVATE NameCacheEntry nameCache[NAME_CACHE];
+/* Changes whenever a name is removed; 0 marks never filled entries */
+PRIVATE volatile unsigned long nameGeneration = 1;
+
+/*
+ * @brief   Hashes a name (FNV-1a) for its chain and cache entry
+ * @param   [in] const char * name: name of up to NAME_LENGTH - 1 characters
+ * @return  unsigned long: hash
+ */
+unsigned long nameHash(const char * name)
+{
+    unsigned long hash = FNV_OFFSET;
+    int i;
+
+    for(i = 0; i < NAME_LENGTH && name[i]; i++)
+    {
+        hash = ((hash ^ (unsigned char)name[i]) * FNV_PRIME) & 0xFFFFFFFFUL;
+    }
+    return hash;
+}
+
+/*
+ * @brief   Finds the mailbox registered under a name, from the lookup
+ *          cache if it holds the name, otherwise from the kernel
+ * @param   [in] const char * name: name registered with registerName()
+ * @return  int: mailbox number; -1 -> no such name
+ */
+int lookupName(const char * name)
+{
+    volatile NameCacheEntry * entry = &nameCache[nameHash(name) & (NAME_CACHE - 1)];
+    NameCacheEntry copy;
+    int i;
+
+    /* The kernel may rewrite the entry between any two reads */
+    copy.sequence = entry->sequence;
+    copy.generation = entry->generation;
+    copy.MB = entry->MB;
+    for(i = 0; i < NAME_LENGTH; i++)
+    {
+        copy.name[i] = entry->name[i];
+    }
+
+    if(copy.sequence == entry->sequence && copy.generation == nameGeneration &&
+       !strncmp(copy.name, name, NAME_LENGTH))
+    {
+        return copy.MB;
+    }
+    return resolveName(name);
+}
+
+/*
+ * @brief   Links every name structure into the free list. Called from
+ *          main() before any process runs.
+ */
+void initNames(void)
+{
+    int i;
+
+    for(i = 0; i < NAME_AMOUNT; i++)
+    {
+        nameList[i].next = freeNames;
+        freeNames = &nameList[i];
+    }
+}
+
+/*
+ * @brief   Finds a name in the hash table
+ * @param   [in] const char * name: name wanted
+ *          [in] unsigned long hash: its nameHash()
+ * @return  Name *: the registered name, NULL if absent
+ */
+PRIVATE Name * findName(const char * name, unsigned long hash)
+{
+    Name * entry = nameTable[hash & (NAME_BUCKETS - 1)];
+
+    while(entry && (entry->hash != hash || strncmp(entry->name, name, NAME_LENGTH)))
+    {
+        entry = entry->next;
+    }
+    return entry;
+}
+
+/*
+ * @brief   Registers a name for a mailbox owned by the caller
+ * @param   [in] PCB * caller: process registering
+ *          [in] const char * name: 1 to NAME_LENGTH - 1 characters
+ *          [in] int MB: mailbox bound by the caller
+ * @return  int: SUCCESS; FAILURE if the caller does not own MB, the
+ *               name is empty, too long or taken, or the table is full
+ */
+int kernelNameRegister(PCB * caller, const char * name, int MB)
+{
+    unsigned long hash;
+    Name * entry;
+
+    if(MB < 0 || MB >= MAILBOX_AMOUNT || getOwnerPCB(MB) != caller ||
+       !name[0] || !memchr(name, NUL, NAME_LENGTH) || !freeNames)
+    {
+        return FAILURE;
+    }
+
+    hash = nameHash(name);
+    if(findName(name, hash))
+    {
+        return FAILURE;
+    }
+
+    entry = freeNames;
+    freeNames = entry->next;
+    strncpy(entry->name, name, NAME_LENGTH);
+    entry->hash = hash;
+    entry->MB = MB;
+    entry->next = nameTable[hash & (NAME_BUCKETS - 1)];
+    nameTable[hash & (NAME_BUCKETS - 1)] = entry;
+    return SUCCESS;
+}
+
+/*
+ * @brief   Resolves a name and caches the result for lookupName()
+ * @param   [in] const char * name: name wanted
+ * @return  int: mailbox number; FAILURE if the name is not registered
+ */
+int kernelNameLookup(const char * name)
+{
+    unsigned long hash = nameHash(name);
+    Name * entry = findName(name, hash);
+    NameCacheEntry * cached = &nameCache[hash & (NAME_CACHE - 1)];
+
+    if(!entry)
+    {
+        return FAILURE;
+    }
+
+    strncpy(cached->name, entry->name, NAME_LENGTH);
+    cached->MB = entry->MB;
+    cached->generation = nameGeneration;
+    cached->sequence++;
+    return entry->MB;
+}
+
+/*
+ * @brief   Removes every name of a mailbox being unbound by its owner
+ * @param   [in] int MB: mailbox released
+ */
+void kernelNameRelease(int MB)
+{
+    Name ** link;
+    Name * entry;
+    int bucket;
+    int removed = FALSE;
+
+    for(bucket = 0; bucket < NAME_BUCKETS; bucket++)
+    {
+        link = &nameTable[bucket];
+        while(*link)
+        {
+            entry = *link;
+            if(entry->MB == MB)
+            {
+                *link = entry->next;
+                entry->next = freeNames;
+                freeNames = entry;
+                removed = TRUE;
+            }
+            else
+            {
+                link = &(entry->next);
+            }
+        }
+    }
+
+    /* Invalidates every cached lookup */
+    if(removed)
+    {
+        nameGeneration++;
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * @file    Names.h
+ * @brief   Mailbox name service.
+ *          A process names a mailbox it owns with registerName(); any
+ *          process finds it with lookupName() instead of a hard-coded
+ *          number. Names live in a kernel hash table of NAME_BUCKETS
+ *          chains and are removed when their mailbox is unbound.
+ *          lookupName() first checks a direct-mapped cache filled by
+ *          the kernel and read in thread mode, so a repeated lookup
+ *          needs no kernel call: each entry carries a sequence the
+ *          kernel bumps when it rewrites the entry, and the generation
+ *          of the table it was filled from, which changes whenever a
+ *          name is removed. resolveName() always asks the kernel.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Process.h"
+
+/* Longest name, terminator included */
+#define NAME_LENGTH         16
+/* Names registered at once */
+#define NAME_AMOUNT         32
+/* Hash chains and lookup cache entries, powers of two */
+#define NAME_BUCKETS        32
+#define NAME_CACHE          16
+
+/*
+ * @brief   Name Structure
+ * @details A registered name, linked in its hash chain or the free list
+ */
+typedef struct Name_
+{
+    char name[NAME_LENGTH];
+    unsigned long hash;
+    int MB;
+    struct Name_ * next;
+}Name;
+
+/*
+ * @brief   Name Cache Entry Structure
+ * @details Written only by the kernel; valid if sequence is unchanged
+ *          across the read and generation is the table's
+ */
+typedef struct NameCacheEntry_
+{
+    volatile unsigned long sequence;
+    unsigned long generation;
+    char name[NAME_LENGTH];
+    int MB;
+}NameCacheEntry;
+
+#ifndef GLOBAL_NAMES
+#define GLOBAL_NAMES
+
+extern unsigned long nameHash(const char *);
+extern int lookupName(const char *);
+extern void initNames(void);
+extern int kernelNameRegister(PCB *, const char *, int);
+extern int kernelNameLookup(const char *);
+extern void kernelNameRelease(int);
+
+#endif /* GLOBAL_NAMES */
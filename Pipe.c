@@ -0,0 +1,161 @@
+/*
+ * @file    Pipe.c
+ * @brief   Contains pipe fragmentation, reassembly and flow control.
+ *          Runs in the processes using the pipe, through the
+ *          messaging kernel calls.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_PIPE
+#include <string.h>
+#include "Pipe.h"
+#include "KernelCall.h"
+#include "Process.h"
+
+/*
+ * @brief   Prepares one end of a pipe
+ * @param   [out] Pipe * pipe: end to initialize
+ *          [in] int MB: mailbox bound by the caller for this end
+ *          [in] int peerMB: mailbox of the other end
+ */
+void pipeOpen(Pipe * pipe, int MB, int peerMB)
+{
+    pipe->MB = MB;
+    pipe->peerMB = peerMB;
+    pipe->credits = PIPE_WINDOW;
+    pipe->consumed = 0;
+    pipe->held = 0;
+    pipe->offset = 0;
+}
+
+/*
+ * @brief   Sends one message of the stream, first waiting for credit
+ *          from the reader if the window is used up
+ * @param   [in/out] Pipe * pipe: writing end
+ *          [in] const void * data: bytes of the message
+ *          [in] int size: 0 to MESSAGE_SYS_LIMIT
+ * @return  int: SUCCESS; SEND_FAIL or RECV_FAIL if a kernel call failed
+ */
+PRIVATE int pipeSend(Pipe * pipe, const void * data, int size)
+{
+    int credit;
+    int fromMB;
+
+    while(pipe->credits <= 0)
+    {
+        if(recvMessage(pipe->MB, &fromMB, &credit, sizeof(credit)) != sizeof(credit))
+        {
+            return RECV_FAIL;
+        }
+        pipe->credits += credit;
+    }
+
+    if(sendMessage(pipe->peerMB, pipe->MB, (void *)data, size) < 0)
+    {
+        return SEND_FAIL;
+    }
+    pipe->credits--;
+    return SUCCESS;
+}
+
+/*
+ * @brief   Writes every byte of data to the pipe, in order
+ * @param   [in/out] Pipe * pipe: writing end
+ *          [in] const void * data: bytes to write
+ *          [in] int size: number of bytes, any length
+ * @return  int: bytes written, size unless a kernel call failed;
+ *               SEND_FAIL if none could be
+ */
+int pipeWrite(Pipe * pipe, const void * data, int size)
+{
+    const char * source = (const char *)data;
+    int written = 0;
+    int chunk;
+
+    while(written < size)
+    {
+        chunk = (size - written < MESSAGE_SYS_LIMIT) ? size - written : MESSAGE_SYS_LIMIT;
+        if(pipeSend(pipe, source + written, chunk) != SUCCESS)
+        {
+            return (written) ? written : SEND_FAIL;
+        }
+        written += chunk;
+    }
+    return written;
+}
+
+/*
+ * @brief   Marks the end of the stream written so far; the reader's
+ *          pipeRead() returns 0 when it reaches it
+ * @param   [in/out] Pipe * pipe: writing end
+ * @return  int: SUCCESS or SEND_FAIL
+ */
+int pipeClose(Pipe * pipe)
+{
+    return (pipeSend(pipe, pipe->chunk, 0) == SUCCESS) ? SUCCESS : SEND_FAIL;
+}
+
+/*
+ * @brief   Counts a message as consumed, returning credit to the writer
+ *          every PIPE_CREDIT messages
+ * @param   [in/out] Pipe * pipe: reading end
+ */
+PRIVATE void pipeConsumed(Pipe * pipe)
+{
+    int credit = PIPE_CREDIT;
+
+    if(++pipe->consumed == PIPE_CREDIT)
+    {
+        pipe->consumed = 0;
+        sendMessage(pipe->peerMB, pipe->MB, &credit, sizeof(credit));
+    }
+}
+
+/*
+ * @brief   Reads up to size bytes of the stream. Returns what remains
+ *          of the last message read before receiving another, so a
+ *          read may return fewer bytes than asked for.
+ * @param   [in/out] Pipe * pipe: reading end
+ *          [out] void * data: receives the bytes
+ *          [in] int size: most bytes wanted
+ * @return  int: bytes read, at least 1 if size is; 0 at end of stream;
+ *               RECV_FAIL if the receive failed
+ */
+int pipeRead(Pipe * pipe, void * data, int size)
+{
+    int fromMB;
+    int copied;
+
+    if(size <= 0)
+    {
+        return 0;
+    }
+
+    if(!pipe->held)
+    {
+        pipe->held = recvMessage(pipe->MB, &fromMB, pipe->chunk, MESSAGE_SYS_LIMIT);
+        if(pipe->held < 0)
+        {
+            pipe->held = 0;
+            return RECV_FAIL;
+        }
+        pipe->offset = 0;
+        if(!pipe->held)
+        {
+            /* End of stream */
+            pipeConsumed(pipe);
+            return 0;
+        }
+    }
+
+    copied = (pipe->held < size) ? pipe->held : size;
+    memcpy(data, &pipe->chunk[pipe->offset], copied);
+    pipe->offset += copied;
+    pipe->held -= copied;
+    if(!pipe->held)
+    {
+        pipeConsumed(pipe);
+    }
+    return copied;
+}
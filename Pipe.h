@@ -0,0 +1,51 @@
+/*
+ * @file    Pipe.h
+ * @brief   Byte-stream pipes over mailboxes.
+ *          pipeWrite() splits data of any length into messages of up to
+ *          MESSAGE_SYS_LIMIT bytes sent to the reader's mailbox, which
+ *          keeps them in order; pipeRead() returns as much of the stream
+ *          as the caller asks for, keeping the rest of a message for the
+ *          next read. Each end is a Pipe structure owned by its process;
+ *          the two ends name each other's mailbox, and each mailbox must
+ *          carry only the pipe's traffic.
+ *          Flow control keeps a pipe from draining the message pool: the
+ *          writer may have PIPE_WINDOW messages unread, and the reader
+ *          returns credit to the writer's mailbox every PIPE_CREDIT
+ *          messages it has consumed.
+ *          pipeClose() sends an empty message, read as end of stream.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Utilities.h"
+
+/* Messages a writer may have outstanding, and the reader's credit batch */
+#define PIPE_WINDOW         8
+#define PIPE_CREDIT         (PIPE_WINDOW / 2)
+
+/*
+ * @brief   Pipe End Structure
+ * @details State of one end of a pipe; a writer uses credits, a reader
+ *          the rest
+ */
+typedef struct Pipe_
+{
+    int MB;//mailbox this end receives on, bound by its process
+    int peerMB;//mailbox of the other end
+    int credits;//writer: messages it may send before awaiting credit
+    int consumed;//reader: messages read since credit was last returned
+    int held;//reader: bytes of chunk not yet read
+    int offset;//reader: index in chunk of the first of them
+    char chunk[MESSAGE_SYS_LIMIT];
+}Pipe;
+
+#ifndef GLOBAL_PIPE
+#define GLOBAL_PIPE
+
+extern void pipeOpen(Pipe *, int, int);
+extern int pipeWrite(Pipe *, const void *, int);
+extern int pipeRead(Pipe *, void *, int);
+extern int pipeClose(Pipe *);
+
+#endif /* GLOBAL_PIPE */
@@ -3,6 +3,7 @@
  * @brief   Contains functionality for getting and
  *          setting the PSP and MSP
  *          Saving and Restoring CPU registers
+ *          SVC exception entry point
  *
  * @author  Larry Hughes (Original)
  * @author  Liam JA MacDonald
@@ -43,6 +44,12 @@ void set_MSP(volatile unsigned long MainStack)
 __asm(" msr msp, r0");
 }
 
+void set_BASEPRI(volatile unsigned long Priority)
+{
+/* Mask interrupts of priority value >= Priority; 0 unmasks all */
+__asm(" msr basepri, r0");
+}
+
 void volatile save_registers()
 {
 /* Save r4..r11 on process stack */
@@ -61,6 +68,28 @@ __asm(" ldmia   r0!,{r4-r11}");
 __asm(" msr psp,r0");
 }
 
+int compare_and_swap(volatile unsigned long * address, unsigned long expected, unsigned long value)
+{
+/* Store value at address (r0) if it holds expected (r1); an exception
+ * between LDREX and STREX, e.g. a context switch, clears the exclusive
+ * monitor so the STREX fails and the pair is retried. Returns TRUE if
+ * stored; usable in Thread mode, no kernel call */
+__asm("CasRetry:");
+__asm("     ldrex   r3,[r0]");
+__asm("     cmp     r3,r1");
+__asm("     bne     CasFail");
+__asm("     strex   r3,r2,[r0]");  /* r3 is 0 if stored */
+__asm("     cmp     r3,#0");
+__asm("     bne     CasRetry");
+__asm("     mov     r0,#1");
+__asm("     bx  lr");
+__asm("CasFail:");
+__asm("     clrex");
+__asm("     mov     r0,#0");
+__asm("     bx  lr");
+return 0;   /***** Not executed -- shuts compiler up */
+}
+
 unsigned long get_SP()
 {
 /**** Leading space required -- for label ****/
@@ -69,5 +98,43 @@ __asm(" bx  lr");
 return 0;
 }
 
+/*
+ * @brief   Entry point of SVC routine
+ */
+void SVCall(void)
+{
+/* Supervisor call (trap) entry point
+ * Using MSP - trapping process either MSP or PSP (specified in LR)
+ * Source is specified in LR: F1 (MSP) or FD (PSP)
+ * Save r4-r11 on trapping process stack (MSP or PSP)
+ * Restore r4-r11 from trapping process stack to CPU
+ * SVCHandler is called with r0 equal to MSP or PSP to access any arguments
+ */
+
+/* Save LR for return via MSP or PSP */
+__asm("     PUSH    {LR}");
 
+/* Trapping source: MSP or PSP? */
+__asm("     TST     LR,#4");    /* Bit #3 (0100b) indicates MSP (0) or PSP (1) */
+__asm("     BNE     RtnViaPSP");
 
+/* Trapping source is MSP - save r4-r11 on stack (default, so just push) */
+__asm("     PUSH    {r4-r11}");
+__asm("     MRS r0,msp");
+__asm("     BL  SVCHandler");   /* r0 is MSP */
+__asm("     POP {r4-r11}");
+__asm("     POP     {PC}");
+
+/* Trapping source is PSP - save r4-r11 on psp stack (MSP is active stack) */
+__asm("RtnViaPSP:");
+__asm("     mrs     r0,psp");
+__asm("     stmdb   r0!,{r4-r11}"); /* Store multiple, decrement before */
+__asm("     msr psp,r0");
+__asm("     BL  SVCHandler");   /* r0 Is PSP */
+
+/* Restore r4..r11 from trapping process stack  */
+__asm("     mrs     r0,psp");
+__asm("     ldmia   r0!,{r4-r11}"); /* Load multiple, increment after */
+__asm("     msr psp,r0");
+__asm("     POP     {PC}");
+}
@@ -17,9 +17,8 @@
 
 #define PRIORITY_LEVELS 5
 
-#define SVC()   __asm(" SVC #0")
-#define disable()   __asm(" cpsid i")
-#define enable()    __asm(" cpsie i")
+#include "Hardware.h"
+
 #define STACKSIZE   1024
 #define MSP_RETURN 0xFFFFFFF9    //LR value: exception return using MSP as SP
 #define PSP_RETURN 0xFFFFFFFD    //LR value: exception return using PSP as SP
@@ -64,8 +63,15 @@ unsigned int pid;
 /* Links to adjacent PCBs */
 struct ProcessControlBlock_ *next;
 struct ProcessControlBlock_ *prev;
-/* Priority of process */
+/* Effective priority of process, raised above basePriority by inheritance */
 unsigned char priority;
+unsigned char basePriority;
+/* Priority given at registration or by nice(); MLFQ mode moves basePriority */
+unsigned char fixedPriority;
+/* MLFQ mode: ticks run at the current level */
+unsigned long quantumUsed;
+/* Server this process waits on a reply from (see MB_OPT_INHERIT) */
+struct ProcessControlBlock_ *waitingOn;
 /* Pointer to message storing space */
 int * returnValue;
 
@@ -74,22 +80,127 @@ int xAxisCursorPosition;
 int* from;
 int size;
 void* contents;
+int receiveMB;//mailbox blocked on, ANY for any of its own, RPC_MB for a reply
+struct ProcessControlBlock_ *nextReceiver;//next blocked on a shared mailbox
+/* Send blocked on a full MB_OVERLOAD_BLOCK mailbox, held until it has room */
+void* sendContents;
+int sendSize;
+int sendFrom;
+struct ProcessControlBlock_ *nextSender;//next blocked sending to the same mailbox
+
+/* RPC (Rpc.h): call waited for, sequence of the next call and replies
+ * not yet waited for */
+int waitingCall;
+unsigned int nextCall;
+struct Message_ * replies;
 
 struct ReceiveLog_ * receiveAnyHead;
 struct ReceiveLog_ * receiveAnyTail;
 
+/* Link in the list of all registered processes */
+struct ProcessControlBlock_ *nextProcess;
+
+/* Accounting: cycle counts are DWT CYCCNT deltas */
+unsigned long cpuCycles;
+unsigned long switchedInAt;
+unsigned long voluntarySwitches;
+unsigned long involuntarySwitches;
+unsigned long messagesSent;
+unsigned long messagesReceived;
+unsigned long blockedCycles;
+unsigned long blockedAt;
+/* SysTick PC samples taken while this process was interrupted */
+unsigned long profileSamples;
+
+/* Timing of EDF and timed processes (EDF.h, Admission.h) in SysTick ticks */
+unsigned long period;
+unsigned long wcet;
+unsigned long relativeDeadline;
+/* Release tick and absolute deadline of the current job */
+unsigned long release;
+unsigned long deadline;
+unsigned long deadlineMisses;
+/* TRUE once the current job's miss has been counted */
+unsigned char deadlineMissed;
+/* Position in the deadline heap while ready */
+int heapIndex;
+/* Periodic release (Timer.h): TRUE while waiting in waitNextPeriod() */
+unsigned char waitingRelease;
+struct Timer_ * releaseTimer;
+
+/* CPU budget (Budget.h) and the next process sharing it */
+struct Budget_ * budget;
+struct ProcessControlBlock_ *nextMember;
+/* TRUE while kept off the CPU by an exhausted BUDGET_HOLD budget */
+unsigned char held;
+
+/* Stack size in bytes of the class topOfStack came from (Spawn.h) */
+unsigned long stackSize;
+/* Process that spawned this one, NULL if registered or orphaned */
+struct ProcessControlBlock_ *parent;
+/* Child waited on in join() */
+struct ProcessControlBlock_ *joining;
+/* Code given to exitProcess(), kept until joined */
+int exitCode;
+/* Channel (Channel.h) blocked on as its reader or writer */
+struct Channel_ * waitingChannel;
+/* Event flags (Events.h); eventMask is non-zero only while waiting on
+ * them, with the wait's mode and timeout timer */
+unsigned long eventFlags;
+unsigned long eventMask;
+int eventMode;
+struct Timer_ * eventTimer;
+/* Semaphore or mutex (Sync.h) blocked on, the next process waiting on
+ * it, and the mutexes this process holds that others wait on */
+struct Semaphore_ * waitingSemaphore;
+struct Mutex_ * waitingMutex;
+struct ProcessControlBlock_ *nextWaiter;
+struct Mutex_ * mutexesHeld;
+
 } PCB;
 
+/* TRUE if the process is off the queues waiting for a message, room
+ * to send one, its period, a budget replenishment, a child, a channel,
+ * event flags, a semaphore or a mutex */
+#define IS_BLOCKED(pcb) ((pcb)->contents || (pcb)->sendContents || (pcb)->waitingRelease || (pcb)->held || \
+                         (pcb)->joining || (pcb)->waitingChannel || (pcb)->eventMask || \
+                         (pcb)->waitingSemaphore || (pcb)->waitingMutex)
+
+/* Snapshot of a process' accounting returned by ps() */
+
+typedef struct ProcessStats_
+{
+unsigned int pid;
+unsigned char priority;
+unsigned char basePriority;
+/* TRUE if blocked (IS_BLOCKED) */
+unsigned char blocked;
+unsigned long cpuCycles;
+unsigned long voluntarySwitches;
+unsigned long involuntarySwitches;
+unsigned long messagesSent;
+unsigned long messagesReceived;
+unsigned long blockedCycles;
+unsigned long profileSamples;
+unsigned long deadlineMisses;
+/* Timing given at registration, 0 if untimed */
+unsigned long period;
+unsigned long wcet;
+unsigned long relativeDeadline;
+} ProcessStats;
+
 
-#ifndef GLOBAL_KERNELCALL
-#define GLOBAL_KERNELCALL
+#ifndef GLOBAL_PROCESS
+#define GLOBAL_PROCESS
 
 extern void set_LR(volatile unsigned long);
 extern unsigned long get_PSP();
 extern void set_PSP(volatile unsigned long);
+extern void set_BASEPRI(volatile unsigned long);
 extern unsigned long get_MSP(void);
 extern void set_MSP(volatile unsigned long);
 extern unsigned long get_SP();
+extern int compare_and_swap(volatile unsigned long *, unsigned long, unsigned long);
 extern void volatile save_registers();
 extern void volatile restore_registers();
 
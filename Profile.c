@@ -0,0 +1,172 @@
+/*
+ * @file    Profile.c
+ * @brief   Contains the SysTick PC sampler, the kernel call reading
+ *          its histogram and the UART dump of a profile
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_PROFILE
+#include "KernelCall.h"
+#include "Profile.h"
+#include "Process.h"
+#include "SVC.h"
+#include "UART.h"
+#include "Utilities.h"
+
+#define HEX_DIGITS_LONG     (sizeof(unsigned long) * 2)
+/* Histogram buckets read per getProfile() call by profileDump() */
+#define DUMP_WINDOW         32
+/* Processes listed by profileDump() */
+#define DUMP_PROCESSES      16
+
+PRIVATE unsigned long histogram[PROFILE_BUCKETS];
+PRIVATE unsigned long samples;
+PRIVATE unsigned long kernelSamples;
+PRIVATE unsigned long outside;
+
+/*
+ * @brief   Called from SYSTICKHandler. If SysTick interrupted a process,
+ *          charges the sample to the RUNNING process and to the
+ *          histogram bucket of the PC it stacked; otherwise (SVC or
+ *          another interrupt was active) counts a kernel sample.
+ */
+void profileSample(void)
+{
+    unsigned long offset;
+
+    samples++;
+    if(!(ICSR_R & ICSR_RETTOBASE))
+    {
+        kernelSamples++;
+        return;
+    }
+
+    getRunningPCB()->profileSamples++;
+    offset = (INTERRUPTED_PC() - PROFILE_BASE) >> PROFILE_SHIFT;
+    if(offset < PROFILE_BUCKETS)
+    {
+        histogram[offset]++;
+    }
+    else
+    {
+        outside++;
+    }
+}
+
+/*
+ * @brief   Copies the sample totals and a range of histogram buckets
+ * @param   [in/out] ProfileWindow * window: first and count give the
+ *          buckets wanted; everything else is filled in
+ * @return  int: number of buckets copied into window->counts;
+ *               -1 -> invalid first bucket
+ */
+int kernelProfile(ProfileWindow * window)
+{
+    int copied = 0;
+
+    if(window->first < 0)
+    {return FAILURE;}
+
+    window->samples = samples;
+    window->kernelSamples = kernelSamples;
+    window->outside = outside;
+    window->base = PROFILE_BASE;
+    window->shift = PROFILE_SHIFT;
+    window->buckets = PROFILE_BUCKETS;
+
+    while(copied < window->count && window->first + copied < PROFILE_BUCKETS)
+    {
+        window->counts[copied] = histogram[window->first + copied];
+        copied++;
+    }
+    return copied;
+}
+
+/*
+ * @brief   Writes a value as fixed width hexadecimal followed by
+ *          a separator character
+ * @param   [in] unsigned long value: value to be written
+ *          [in] char separator: character written after the value
+ */
+PRIVATE void profileHex(unsigned long value, char separator)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    int digits = HEX_DIGITS_LONG;
+
+    while(digits--)
+    {
+        forceOutput(hexDigits[(value >> (digits * 4)) & 0xF]);
+    }
+    forceOutput(separator);
+}
+
+/*
+ * @brief   Writes a NUL terminated string
+ * @param   [in] char * string: string to be written
+ */
+PRIVATE void profileString(char * string)
+{
+    while(*string)
+    {
+        forceOutput(*(string++));
+    }
+}
+
+/*
+ * @brief   Writes the profile to UART0 as text. Called from a process.
+ *          Output format (all values hex), non-zero buckets only:
+ *              PROFILE <base> <shift> <buckets> <samples> <kernel> <outside>
+ *              B <bucket> <count>
+ *              ...
+ *              P <pid> <samples>
+ *              ...
+ *              END
+ */
+void profileDump(void)
+{
+    unsigned long counts[DUMP_WINDOW];
+    ProcessStats table[DUMP_PROCESSES];
+    ProfileWindow window;
+    int processes;
+    int copied;
+    int i;
+
+    window.first = 0;
+    window.count = DUMP_WINDOW;
+    window.counts = counts;
+    copied = getProfile(&window);
+
+    profileString("\r\nPROFILE ");
+    profileHex(window.base, ' ');
+    profileHex(window.shift, ' ');
+    profileHex(window.buckets, ' ');
+    profileHex(window.samples, ' ');
+    profileHex(window.kernelSamples, ' ');
+    profileHex(window.outside, '\n');
+
+    while(copied > 0)
+    {
+        for(i = 0; i < copied; i++)
+        {
+            if(counts[i])
+            {
+                profileString("B ");
+                profileHex(window.first + i, ' ');
+                profileHex(counts[i], '\n');
+            }
+        }
+        window.first += copied;
+        copied = getProfile(&window);
+    }
+
+    processes = ps(table, DUMP_PROCESSES);
+    for(i = 0; i < processes; i++)
+    {
+        profileString("P ");
+        profileHex(table[i].pid, ' ');
+        profileHex(table[i].profileSamples, '\n');
+    }
+
+    profileString("END\n");
+}
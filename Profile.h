@@ -0,0 +1,78 @@
+/*
+ * @file    Profile.h
+ * @brief   Statistical PC-sampling profiler.
+ *          Each SysTick interrupt samples the PC stacked by the
+ *          interrupted process, counting it against the process and
+ *          in an address histogram. Compiled in only when KERNEL_PROFILE
+ *          is defined (e.g. --define=KERNEL_PROFILE), otherwise
+ *          PROFILE_SAMPLE() expands to nothing.
+ *          tools/profile.py turns profileDump() output and the linker
+ *          map into a per-function flat profile.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Hardware.h"
+
+/* Interrupt Control and State Register */
+#define ICSR_R              HW_REGISTER(0xE000ED04)
+/* Set when no exception other than the current one is active,
+ * i.e. SysTick interrupted Thread mode (a process) */
+#define ICSR_RETTOBASE      0x00000800
+
+/* Word offset of the PC in the frame stacked on exception entry */
+#define STACKED_PC          6
+
+/* Histogram covers PROFILE_BUCKETS ranges of 2^PROFILE_SHIFT bytes from PROFILE_BASE */
+#ifndef PROFILE_BASE
+#define PROFILE_BASE        0x00000000UL    // Start of flash
+#endif
+#ifndef PROFILE_SHIFT
+#define PROFILE_SHIFT       5
+#endif
+#ifndef PROFILE_BUCKETS
+#define PROFILE_BUCKETS     1024
+#endif
+
+/* PC of the process interrupted by SysTick; Hardware.h may substitute its own */
+#ifndef INTERRUPTED_PC
+#define INTERRUPTED_PC()    (((unsigned long *)get_PSP())[STACKED_PC])
+#endif
+
+/*
+ * @brief   Profile Window Structure
+ * @details Passed to getProfile() to read the sample totals and
+ *          a range of histogram buckets
+ */
+typedef struct ProfileWindow_
+{
+    unsigned long samples;//[out] SysTick interrupts sampled
+    unsigned long kernelSamples;//[out] samples that interrupted another exception
+    unsigned long outside;//[out] process samples outside the histogram
+    unsigned long base;//[out] address of bucket 0
+    int shift;//[out] log2 of the bucket width in bytes
+    int buckets;//[out] number of buckets
+    int first;//[in] first bucket wanted
+    int count;//[in] entries available in counts
+    unsigned long * counts;//[out] counts[i] is bucket first + i
+}ProfileWindow;
+
+#ifdef KERNEL_PROFILE
+
+#define PROFILE_SAMPLE()    profileSample()
+
+#else
+
+#define PROFILE_SAMPLE()    do {} while(0)
+
+#endif /* KERNEL_PROFILE */
+
+#ifndef GLOBAL_PROFILE
+#define GLOBAL_PROFILE
+
+extern void profileSample(void);
+extern int kernelProfile(ProfileWindow *);
+extern void profileDump(void);
+
+#endif /* GLOBAL_PROFILE */
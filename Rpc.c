@@ -0,0 +1,226 @@
+/*
+ * @file    Rpc.c
+ * @brief   Contains the server side request receive and the kernel
+ *          side of RPC calls, replies and reply channels
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_RPC
+#include <string.h>
+#include "Rpc.h"
+#include "KernelCall.h"
+#include "Messages.h"
+#include "SVC.h"
+#include "DWT.h"
+#include "MLFQ.h"
+#include "Utilities.h"
+
+/*
+ * @brief   Receives the next message on a server mailbox, separating
+ *          the call ID from the request data
+ * @param   [in] int MB: mailbox bound by the server
+ *          [out] int * callId: ID to reply to; FAILURE if the message
+ *                was sent with sendMessage() rather than as a request
+ *          [out] void * request: receives the request data
+ *          [in] int maxSize: most bytes wanted
+ * @return  int: bytes copied to request; RECV_FAIL if the receive failed
+ */
+int rpcReceive(int MB, int * callId, void * request, int maxSize)
+{
+    char message[MESSAGE_SYS_LIMIT];
+    RpcHeader header;
+    int fromMB;
+    int size = recvMessage(MB, &fromMB, message, MESSAGE_SYS_LIMIT);
+    int offset = 0;
+
+    if(size < 0)
+    {
+        return RECV_FAIL;
+    }
+
+    *callId = FAILURE;
+    if(fromMB == RPC_MB && size >= (int)sizeof(RpcHeader))
+    {
+        memcpy(&header, message, sizeof(RpcHeader));
+        *callId = header.callId;
+        offset = sizeof(RpcHeader);
+        size -= offset;
+    }
+
+    size = (size < maxSize) ? size : maxSize;
+    memcpy(request, &message[offset], size);
+    return size;
+}
+
+/*
+ * @brief   Sends a request to a server mailbox under a new call ID.
+ *          A request to a mailbox with MB_OPT_INHERIT makes its owner
+ *          the server the caller waits on.
+ * @param   [in/out] PCB * caller: client process
+ *          [in] RpcArgs * args: serverMB, contents and size
+ * @return  int: call ID; FAILURE if size exceeds RPC_LIMIT or the
+ *               caller's pid is not below RPC_PID_LIMIT; SEND_FAIL
+ *               if the mailbox is unbound or the pool is empty
+ */
+int kernelRpcSend(PCB * caller, RpcArgs * args)
+{
+    char request[MESSAGE_SYS_LIMIT];
+    RpcHeader header;
+    int callId;
+
+    if(args->size < 0 || args->size > RPC_LIMIT || caller->pid >= RPC_PID_LIMIT)
+    {
+        return FAILURE;
+    }
+
+    callId = (int)((caller->pid << RPC_SEQUENCE_BITS) | caller->nextCall);
+    header.callId = callId;
+    memcpy(request, &header, sizeof(RpcHeader));
+    memcpy(&request[sizeof(RpcHeader)], args->contents, args->size);
+
+    if(kernelPost(args->serverMB, RPC_MB, request, sizeof(RpcHeader) + args->size) != SUCCESS)
+    {
+        return SEND_FAIL;
+    }
+
+    caller->nextCall = (caller->nextCall + 1) & RPC_SEQUENCE_MASK;
+    caller->messagesSent++;
+    if(mailboxInherits(args->serverMB))
+    {
+        caller->waitingOn = getOwnerPCB(args->serverMB);
+    }
+    return callId;
+}
+
+/*
+ * @brief   Collects the reply to one of the caller's calls, blocking
+ *          until it arrives if it has not already
+ * @param   [in/out] PCB * caller: client process
+ *          [in] int callId: ID returned by rpcSend()
+ *          [out] void * contents: receives the reply
+ *          [in] int maxSize: most bytes wanted
+ *          [out] int * returnValue: receives the bytes copied, now or
+ *                when the reply arrives; RECV_FAIL if callId is not one
+ *                of the caller's or contents is NULL
+ * @return  int: TRUE if the caller blocked
+ */
+int kernelRpcWait(PCB * caller, int callId, void * contents, int maxSize, int * returnValue)
+{
+    Message ** link = &caller->replies;
+    Message * reply;
+
+    if(RPC_CALLER(callId) != caller->pid || !contents)
+    {
+        *returnValue = RECV_FAIL;
+        return FALSE;
+    }
+
+    while(*link && (*link)->from != callId)
+    {
+        link = &((*link)->next);
+    }
+
+    if(*link)
+    {
+        reply = *link;
+        *link = reply->next;
+        *returnValue = (reply->size < maxSize) ? reply->size : maxSize;
+        memcpy(contents, reply->contents, *returnValue);
+        addToPool(reply);
+        caller->messagesReceived++;
+        return FALSE;
+    }
+
+    removePCB();
+    caller->contents = contents;
+    caller->size = maxSize;
+    caller->returnValue = returnValue;
+    caller->receiveMB = RPC_MB;
+    caller->waitingCall = callId;
+    caller->blockedAt = CYCLE_COUNT();
+    mlfqBlock(caller);
+
+    //lend this process' priority to the server it waits on
+    if(caller->waitingOn)
+    {
+        inheritPriority(caller->waitingOn, caller->priority);
+    }
+    return TRUE;
+}
+
+/*
+ * @brief   Answers a call: wakes the client if it is blocked waiting
+ *          for this reply, otherwise holds the reply on its channel
+ * @param   [in/out] PCB * server: process replying
+ *          [in] int callId: ID given with the request
+ *          [in] void * contents: reply data
+ *          [in] int size: bytes of contents
+ * @return  int: SUCCESS; SEND_FAIL if the client no longer exists,
+ *               size is too large or the pool is empty
+ */
+int kernelRpcReply(PCB * server, int callId, void * contents, int size)
+{
+    PCB * caller = findProcess(RPC_CALLER(callId));
+    Message * reply;
+    int copySize;
+
+    if(!caller || size < 0 || size > MESSAGE_SYS_LIMIT)
+    {
+        return SEND_FAIL;
+    }
+
+    if(caller->contents && caller->receiveMB == RPC_MB && caller->waitingCall == callId)
+    {
+        copySize = (caller->size < size) ? caller->size : size;
+        memcpy(caller->contents, contents, copySize);
+        *(caller->returnValue) = copySize;
+        caller->contents = NULL;
+        caller->messagesReceived++;
+        caller->blockedCycles += CYCLE_COUNT() - caller->blockedAt;
+        addPCB(caller, caller->priority);
+    }
+    else
+    {
+        reply = retrieveFromPool();
+        if(!reply)
+        {
+            return SEND_FAIL;
+        }
+        reply->from = callId;
+        reply->size = size;
+        memcpy(reply->contents, contents, size);
+        reply->next = caller->replies;
+        caller->replies = reply;
+    }
+
+    //a reply to a client waiting on this process ends any priority it lent
+    if(caller->waitingOn == server)
+    {
+        caller->waitingOn = NULL;
+        if(server->priority != server->basePriority)
+        {
+            restorePriority(server);
+        }
+    }
+
+    server->messagesSent++;
+    return SUCCESS;
+}
+
+/*
+ * @brief   Returns the replies an exiting process never waited for
+ *          to the message pool
+ * @param   [in/out] PCB * pcb: process exiting
+ */
+void rpcRelease(PCB * pcb)
+{
+    Message * reply;
+
+    while(pcb->replies)
+    {
+        reply = pcb->replies;
+        pcb->replies = reply->next;
+        addToPool(reply);
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * @file    Rpc.h
+ * @brief   Request/reply calls between processes.
+ *          A client needs no mailbox of its own: rpcCall() sends a
+ *          request to a server's mailbox and blocks for the reply in a
+ *          single kernel call. Every request carries a call ID naming
+ *          the client and a sequence number; the server passes it to
+ *          rpcReply(), which hands the reply to the client's implicit
+ *          reply channel. rpcSend() and rpcWait() split a call, so a
+ *          client may have several outstanding and collect the replies
+ *          in any order; replies not yet waited for are held in message
+ *          pool messages on the client's PCB until it exits.
+ *          Servers take requests with rpcReceive(), which reports the
+ *          call ID, or FAILURE for a plain message.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Process.h"
+
+/* Call IDs are (pid << RPC_SEQUENCE_BITS) | sequence */
+#define RPC_SEQUENCE_BITS   16
+#define RPC_SEQUENCE_MASK   ((1 << RPC_SEQUENCE_BITS) - 1)
+/* Pids below this keep a 32-bit call ID positive, clear of the
+ * failure codes; larger ones cannot make calls */
+#define RPC_PID_LIMIT       (1U << (31 - RPC_SEQUENCE_BITS))
+/* Client pid of a call ID */
+#define RPC_CALLER(callId)  ((unsigned int)(callId) >> RPC_SEQUENCE_BITS)
+/* Sender mailbox reported with a request; receive mailbox of a client
+ * blocked for a reply */
+#define RPC_MB              -2
+
+/*
+ * @brief   RPC Request Header
+ * @details Precedes the request data in the server's message
+ */
+typedef struct RpcHeader_
+{
+    int callId;
+}RpcHeader;
+
+/* Largest request, in bytes */
+#define RPC_LIMIT           (MESSAGE_SYS_LIMIT - (int)sizeof(RpcHeader))
+
+/*
+ * @brief   RPC Argument Structure
+ * @details Arguments of the RPC kernel calls; each uses those it needs
+ */
+typedef struct RpcArgs_
+{
+    int serverMB;//mailbox a request is sent to
+    int callId;//call waited for or replied to
+    void * contents;//request or reply data
+    int size;//bytes of contents
+    void * reply;//receives the reply
+    int maxSize;//most bytes of reply wanted
+}RpcArgs;
+
+#ifndef GLOBAL_RPC
+#define GLOBAL_RPC
+
+extern int rpcReceive(int, int *, void *, int);
+extern int kernelRpcSend(PCB *, RpcArgs *);
+extern int kernelRpcWait(PCB *, int, void *, int, int *);
+extern int kernelRpcReply(PCB *, int, void *, int);
+extern void rpcRelease(PCB *);
+
+#endif /* GLOBAL_RPC */
@@ -11,21 +11,41 @@
  * @date    13-Nov-2019 (edited)
  */
 #define GLOBAL_SVC
+#include <string.h>
 #include "SVC.h"
 #include "Process.h"
 #include "KernelCall.h"
 #include "Messages.h"
 #include "Utilities.h"
 #include "SYSTICK.h"
+#include "Trace.h"
+#include "DWT.h"
+#include "Profile.h"
+#include "EDF.h"
+#include "Admission.h"
+#include "Timer.h"
+#include "Budget.h"
+#include "MLFQ.h"
+#include "Spawn.h"
+#include "Channel.h"
+#include "Rpc.h"
+#include "Names.h"
+#include "Interrupts.h"
+#include "Events.h"
+#include "Sync.h"
 
 #define HIGH_PRIORITY 4
 #define LOW_PRIORITY 0
 #define PRIORITY_LEVELS 5
+/* Fixed priority levels plus the EDF class above them */
+#define QUEUE_LEVELS (EDF_PRIORITY + 1)
 #define RUNNING waitingToRun[currentPriority]
-#define STACK_SIZE 1024*sizeof(unsigned long)
-#define INIT_SP (1024-16)*sizeof(unsigned long)
 #define THUMB_MODE 0x01000000
+/* Longest chain of servers blocked on servers that inheritance follows */
+#define INHERIT_DEPTH PRIORITY_LEVELS
 static int currentPriority = 0;
+/* Last SysTick pendSV accounted for */
+static unsigned long lastTick = 0;
 
 #define MAX_STACK_SIZE (1024U)
 #define STARTING_PSR (0x01000000U)
@@ -34,7 +54,172 @@ static int currentPriority = 0;
 
 extern void terminate(void);
 
-static PCB * waitingToRun[PRIORITY_LEVELS];
+static PCB * waitingToRun[QUEUE_LEVELS];
+
+/* Number of registered EDF processes */
+static int edfProcesses = 0;
+
+/* SVCHandler latency of each kernel call code */
+static LatencyHistogram callLatency[KERNEL_CALL_CODES];
+
+/* List of every registered process, blocked or not, linked through nextProcess */
+static PCB * processList = NULL;
+
+/* Process in thread mode, set on every switch for getThreadProcess() */
+static PCB * volatile threadProcess = NULL;
+
+/*
+ * @brief   Charges the outgoing process for its time on the CPU and
+ *          starts timing the incoming process
+ * @param   [in/out] PCB * from: process leaving the CPU, NULL if it terminated
+ *          [in/out] PCB * to: process being switched in
+ *          [in] int voluntary: TRUE if the switch is due to a kernel call
+ *               made by from, FALSE if from was preempted
+ */
+PRIVATE void accountSwitch(PCB * from, PCB * to, int voluntary)
+{
+    unsigned long now = CYCLE_COUNT();
+
+    if(from)
+    {
+        from->cpuCycles += now - from->switchedInAt;
+        if(voluntary)
+        {
+            from->voluntarySwitches++;
+        }
+        else
+        {
+            from->involuntarySwitches++;
+        }
+    }
+    to->switchedInAt = now;
+    threadProcess = to;
+    budgetSwitch(from, to);
+    TRACE(TRACE_SWITCH, to->pid, (from) ? from->pid : 0);
+}
+
+/*
+ * @brief   Copies the latency histogram of a kernel call code
+ * @param   [in] unsigned long code: kernel call code
+ *          [out] LatencyHistogram * histogram: destination
+ * @return  int: SUCCESS or FAILURE if code is not a kernel call
+ */
+int kernelLatency(unsigned long code, LatencyHistogram * histogram)
+{
+    if(code >= KERNEL_CALL_CODES)
+    {
+        return FAILURE;
+    }
+
+    memcpy(histogram, &callLatency[code], sizeof(LatencyHistogram));
+    return SUCCESS;
+}
+
+/*
+ * @brief   Removes a PCB from the list of registered processes
+ * @param   [in] PCB * toUnlink: PCB of the process being removed
+ */
+PRIVATE void unlinkProcess(PCB * toUnlink)
+{
+    PCB ** link = &processList;
+
+    while(*link && *link != toUnlink)
+    {
+        link = &((*link)->nextProcess);
+    }
+
+    if(*link)
+    {
+        *link = toUnlink->nextProcess;
+    }
+
+    /* Nobody can wait on a reply from a process that no longer exists */
+    for(link = &processList; *link; link = &((*link)->nextProcess))
+    {
+        if((*link)->waitingOn == toUnlink)
+        {
+            (*link)->waitingOn = NULL;
+        }
+    }
+}
+
+/*
+ * @brief   Copies the accounting of every registered process into
+ *          a caller supplied table
+ * @param   [out] ProcessStats * table: destination of the snapshot
+ *          [in] int maxEntries: number of entries table can hold
+ * @return  int: number of entries written
+ */
+int kernelProcessStats(ProcessStats * table, int maxEntries)
+{
+    PCB * process = processList;
+    int count = 0;
+
+    while(process && count < maxEntries)
+    {
+        table->pid = process->pid;
+        table->priority = process->priority;
+        table->basePriority = process->basePriority;
+        table->period = process->period;
+        table->wcet = process->wcet;
+        table->relativeDeadline = process->relativeDeadline;
+        table->cpuCycles = process->cpuCycles;
+        /* The caller is on the CPU right now so add its current interval */
+        if(process == RUNNING)
+        {
+            table->cpuCycles += CYCLE_COUNT() - process->switchedInAt;
+        }
+        table->voluntarySwitches = process->voluntarySwitches;
+        table->involuntarySwitches = process->involuntarySwitches;
+        table->messagesSent = process->messagesSent;
+        table->messagesReceived = process->messagesReceived;
+        table->blockedCycles = process->blockedCycles;
+        table->profileSamples = process->profileSamples;
+        table->deadlineMisses = process->deadlineMisses;
+        table->blocked = IS_BLOCKED(process);
+        table++;
+        count++;
+        process = process->nextProcess;
+    }
+
+    return count;
+}
+/*
+ * @brief   Finds a registered process
+ * @param   [in] unsigned int pid: Process ID of interest
+ * @return  PCB *: its PCB, NULL if no process has that pid
+ */
+PCB * findProcess(unsigned int pid)
+{
+    PCB * process = processList;
+
+    while(process && process->pid != pid)
+    {
+        process = process->nextProcess;
+    }
+    return process;
+}
+
+/*
+ * @brief   returns the list of registered processes
+ * @return  PCB *: first process, the rest linked through nextProcess
+ */
+PCB * getProcessList(void)
+{
+    return processList;
+}
+
+/*
+ * @brief   Returns the PCB of the process in thread mode without a
+ *          kernel call: unlike RUNNING it is only changed by a context
+ *          switch, so the process reading it always finds itself
+ * @return  PCB *: the calling process
+ */
+PCB * getThreadProcess(void)
+{
+    return threadProcess;
+}
+
 /*
  * @brief   returns PCB of running process
  * @return  PCB *: address of running processes
@@ -46,9 +231,79 @@ PCB * getRunningPCB(void)
 }
 
 /*
- * @brief   Allocates a new process stack frame and PCB
- *          for the process being registered.
- *          sets PCB sp and pid.
+ * @brief   Takes a PCB and stack from the process pool (Spawn.h),
+ *          builds the initial stack frame and adds the process to
+ *          the list of registered processes. sets PCB sp and pid.
+ * @param   [in] void (*code)(void): pointer to the start of the process code
+ *          [in] unsigned int pid: Process ID of process being registered
+ *          [in] unsigned char priority: Process' base priority
+ *          [in] unsigned long stackSize: bytes of stack needed
+ * @return  PCB *: the new PCB, not yet in a waitingToRun queue;
+ *          NULL if the pool has no PCB or stack large enough
+ */
+PCB * createProcess(void (*code)(void), unsigned int pid, int priority, unsigned long stackSize)
+{
+       PCB * newProcess = allocProcess(stackSize);
+       if(!newProcess)
+       {
+           return NULL;
+       }
+       StackFrame *processSP = (StackFrame*) (newProcess->topOfStack + newProcess->stackSize - sizeof(StackFrame));
+       processSP -> psr = THUMB_MODE;
+       processSP -> pc = (unsigned long)code;
+       processSP -> lr = (unsigned long)terminate;
+       newProcess -> sp = (unsigned long) processSP;
+       newProcess -> pid = pid;
+
+       newProcess->contents=NULL;
+       newProcess->size=0;
+       newProcess->from=NULL;
+       newProcess->receiveMB=ANY;
+       newProcess->nextReceiver=NULL;
+       newProcess->sendContents=NULL;
+       newProcess->sendSize=newProcess->sendFrom=0;
+       newProcess->nextSender=NULL;
+       newProcess->waitingCall=newProcess->nextCall=0;
+       newProcess->replies=NULL;
+       newProcess->xAxisCursorPosition=0;
+       newProcess->receiveAnyHead=newProcess->receiveAnyTail=NULL;
+
+       newProcess->cpuCycles=newProcess->switchedInAt=0;
+       newProcess->voluntarySwitches=newProcess->involuntarySwitches=0;
+       newProcess->messagesSent=newProcess->messagesReceived=0;
+       newProcess->blockedCycles=newProcess->blockedAt=0;
+       newProcess->profileSamples=0;
+       newProcess->basePriority=priority;
+       newProcess->fixedPriority=priority;
+       newProcess->quantumUsed=0;
+       newProcess->waitingOn=NULL;
+       newProcess->period=newProcess->wcet=newProcess->relativeDeadline=0;
+       newProcess->deadline=newProcess->deadlineMisses=0;
+       newProcess->deadlineMissed=FALSE;
+       newProcess->release=0;
+       newProcess->waitingRelease=FALSE;
+       newProcess->releaseTimer=NULL;
+       newProcess->budget=NULL;
+       newProcess->nextMember=NULL;
+       newProcess->held=FALSE;
+       newProcess->parent=newProcess->joining=NULL;
+       newProcess->exitCode=0;
+       newProcess->waitingChannel=NULL;
+       newProcess->eventFlags=newProcess->eventMask=0;
+       newProcess->eventMode=EVENT_ANY;
+       newProcess->eventTimer=NULL;
+       newProcess->waitingSemaphore=NULL;
+       newProcess->waitingMutex=NULL;
+       newProcess->nextWaiter=NULL;
+       newProcess->mutexesHeld=NULL;
+       newProcess->nextProcess = processList;
+       processList = newProcess;
+
+       return newProcess;
+}
+
+/*
+ * @brief   Registers a fixed priority process.
  *          calls addPCB to add PCB to waitingToRun with
  *          respective priority
  * @param   [in] void (*code)(void): pointer to the start of the process code
@@ -62,27 +317,22 @@ PCB * getRunningPCB(void)
 int registerProcess(void (*code)(void), unsigned int pid, int priority)
 {
    int result = 0;
+   PCB * newProcess;
 
    /* First must check to ensure the requested priority is valid */
    if((priority >= LOW_PRIORITY) && (priority <= HIGH_PRIORITY))
    {
-
        /* Requested priority is valid so continue with process registration */
-       PCB * newProcess = (PCB*)malloc(sizeof(PCB));
-       newProcess->topOfStack = (unsigned long)malloc(STACK_SIZE);
-       StackFrame *processSP = (StackFrame*) (newProcess->topOfStack+(INIT_SP));
-       processSP -> psr = THUMB_MODE;
-       processSP -> pc = (unsigned long)code;
-       processSP -> lr = (unsigned long)terminate;
-       newProcess -> sp = (unsigned long) processSP;
-       newProcess -> pid = pid;
-
-       newProcess->contents=NULL;
-       newProcess->size=NULL;
-       newProcess->from=NULL;
-       newProcess->xAxisCursorPosition=NULL;
-       newProcess->receiveAnyHead=newProcess->receiveAnyTail=NULL;
-       addPCB(newProcess, priority);
+       newProcess = createProcess(code, pid, priority, DEFAULT_STACK_SIZE);
+       if(newProcess)
+       {
+           addPCB(newProcess, priority);
+       }
+       else
+       {
+           /* Process pool exhausted */
+           result = 1;
+       }
    }
    else
    {
@@ -92,6 +342,146 @@ int registerProcess(void (*code)(void), unsigned int pid, int priority)
    return result;
 }
 
+/*
+ * @brief   Registers an earliest deadline first process (EDF.h).
+ *          Its first job is released immediately.
+ * @param   [in] void (*code)(void): pointer to the start of the process code
+ *          [in] unsigned int pid: Process ID of process being registered
+ *          [in] unsigned long period: least ticks between job releases
+ *          [in] unsigned long deadline: ticks from a release to the
+ *               deadline of its job, 1 to period
+ * @return  int: 0 if registered; 1 if the timing is invalid,
+ *               EDF_PROCESSES are already registered or the process
+ *               pool is exhausted
+ */
+int registerEDFProcess(void (*code)(void), unsigned int pid,
+                       unsigned long period, unsigned long deadline)
+{
+    PCB * newProcess;
+
+    if(!deadline || deadline > period || edfProcesses >= EDF_PROCESSES)
+    {
+        return 1;
+    }
+
+    newProcess = createProcess(code, pid, EDF_PRIORITY, DEFAULT_STACK_SIZE);
+    if(!newProcess)
+    {
+        return 1;
+    }
+    newProcess->period = period;
+    newProcess->relativeDeadline = deadline;
+    edfRelease(newProcess, sysTicks());
+    edfProcesses++;
+    addPCB(newProcess, EDF_PRIORITY);
+    return 0;
+}
+
+/*
+ * @brief   Registers a process with a period, WCET and deadline if
+ *          the analysis of Admission.c finds that it and every timed
+ *          process already registered will meet their deadlines
+ * @param   [in] void (*code)(void): pointer to the start of the process code
+ *          [in] unsigned int pid: Process ID of process being registered
+ *          [in] int priority: fixed priority, or EDF_PRIORITY
+ *          [in] unsigned long period: least ticks between job releases
+ *          [in] unsigned long wcet: longest ticks of CPU a job needs
+ *          [in] unsigned long deadline: ticks from a release to the
+ *               deadline of its job, wcet to period
+ * @return  int: 0 if registered; 1 if the arguments are invalid or the
+ *               process set would not be schedulable
+ */
+int registerTimedProcess(void (*code)(void), unsigned int pid, int priority,
+                         unsigned long period, unsigned long wcet, unsigned long deadline)
+{
+    TaskTiming table[ADMISSION_TASKS];
+    PCB * process;
+    unsigned long density;
+    int count = 0;
+
+    if(!wcet || wcet > deadline || deadline > period ||
+       !(((priority >= LOW_PRIORITY) && (priority <= HIGH_PRIORITY)) || priority == EDF_PRIORITY))
+    {
+        return 1;
+    }
+
+    for(process = processList; process; process = process->nextProcess)
+    {
+        if(process->period)
+        {
+            if(count == ADMISSION_TASKS - 1)
+            {
+                return 1;
+            }
+            table[count].pid = process->pid;
+            table[count].priority = process->basePriority;
+            table[count].period = process->period;
+            table[count].wcet = process->wcet;
+            table[count].deadline = process->relativeDeadline;
+            count++;
+        }
+    }
+    table[count].pid = pid;
+    table[count].priority = priority;
+    table[count].period = period;
+    table[count].wcet = wcet;
+    table[count].deadline = deadline;
+    count++;
+
+    if(!analyseTasks(table, count, &density))
+    {
+        return 1;
+    }
+
+    if(priority == EDF_PRIORITY)
+    {
+        if(registerEDFProcess(code, pid, period, deadline))
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        if(registerProcess(code, pid, priority))
+        {
+            return 1;
+        }
+        processList->period = period;
+        processList->relativeDeadline = deadline;
+        edfRelease(processList, sysTicks());
+    }
+    /* The new process is at the head of processList */
+    processList->wcet = wcet;
+    return 0;
+}
+
+/*
+ * @brief   Adds a ready EDF process to the EDF level. The earliest
+ *          deadline takes the level's only queue entry and the
+ *          other goes to the deadline heap.
+ * @param   [in/out] PCB * newPCB: PCB being added
+ */
+PRIVATE void addEDF(PCB * newPCB)
+{
+    PCB * earliest = waitingToRun[EDF_PRIORITY];
+
+    newPCB->next = newPCB;
+    newPCB->prev = newPCB;
+    if(!earliest)
+    {
+        waitingToRun[EDF_PRIORITY] = newPCB;
+    }
+    else if(DEADLINE_BEFORE(newPCB->deadline, earliest->deadline))
+    {
+        edfInsert(earliest);
+        waitingToRun[EDF_PRIORITY] = newPCB;
+    }
+    else
+    {
+        edfInsert(newPCB);
+    }
+}
+
 /*
  * @brief   Adds a PCB to the end of a waitingToRun queue.
  *          If its the first process in the queue its next
@@ -104,11 +494,27 @@ int registerProcess(void (*code)(void), unsigned int pid, int priority)
  * */
 int addPCB(PCB *newPCB, int newPriority)
 {
+    /* An exhausted budget holds the process or queues it in the background */
+    int queued = budgetQueue(newPCB, newPriority);
+
+    if(queued < 0)
+    {
+        newPCB->priority = newPriority;
+        return currentPriority;
+    }
+    newPriority = queued;
+
+    /* EDF processes are ordered by deadline rather than queued */
+    if(newPriority == EDF_PRIORITY)
+    {
+        addEDF(newPCB);
+    }
     /* Must check whether desired queue is empty */
-    if(waitingToRun[newPriority] != NULL)
+    else if(waitingToRun[newPriority] != NULL)
     {
         /* Must add process to tail of priority queue */
         newPCB->next = waitingToRun[newPriority];
+        newPCB->prev = waitingToRun[newPriority] -> prev;
         waitingToRun[newPriority] -> prev -> next = newPCB;
         waitingToRun[newPriority] -> prev = newPCB;
     }
@@ -136,10 +542,11 @@ PCB * removePCB()
     /* Check whether process is the queue's only entry */
     if (RUNNING == RUNNING -> next )
     {
-        /* This waiting to run queue is now empty so
+        /* The EDF level's entry is replaced by the next earliest deadline.
+         * If this waiting to run queue is now empty
          * must move to the next highest priority.
          */
-        RUNNING = NULL;
+        RUNNING = (currentPriority == EDF_PRIORITY) ? edfPop() : NULL;
         decrementPriority();
     }
     else
@@ -169,80 +576,184 @@ void decrementPriority(void)
     return;
 }
 
+/*
+ * @brief   Removes any ready PCB from its waitingToRun queue; if it
+ *          was RUNNING the next PCB of the queue becomes RUNNING
+ * @param   [in/out] PCB * toUnlink: PCB being removed
+ */
+void unlinkPCB(PCB * toUnlink)
+{
+    if(toUnlink == RUNNING)
+    {
+        removePCB();
+        return;
+    }
+
+    /* Only the running EDF process is in waitingToRun, the rest are in the heap */
+    if(toUnlink->priority == EDF_PRIORITY)
+    {
+        edfRemove(toUnlink);
+        return;
+    }
+
+    if(toUnlink->next == toUnlink)
+    {
+        waitingToRun[toUnlink->priority] = NULL;
+    }
+    else
+    {
+        toUnlink->next->prev = toUnlink->prev;
+        toUnlink->prev->next = toUnlink->next;
+        if(waitingToRun[toUnlink->priority] == toUnlink)
+        {
+            waitingToRun[toUnlink->priority] = toUnlink->next;
+        }
+    }
+}
+
+/*
+ * @brief   Changes the effective priority of a process. A ready
+ *          process is moved with unlinkPCB()/addPCB(); a blocked one
+ *          (receiving or waiting on its period) is queued at the new
+ *          priority when it is woken.
+ * @param   [in/out] PCB * process: process to move
+ *          [in] int newPriority: its new effective priority
+ */
+void changePriority(PCB * process, int newPriority)
+{
+    if(process->priority == newPriority)
+    {
+        return;
+    }
+
+    if(IS_BLOCKED(process))
+    {
+        process->priority = newPriority;
+    }
+    else
+    {
+        unlinkPCB(process);
+        addPCB(process, newPriority);
+    }
+}
+
+/*
+ * @brief   Finds the highest priority of the blocked processes
+ *          waiting on a reply from a server or on a mutex it holds.
+ *          An EDF client lends HIGH_PRIORITY, as a server has no
+ *          deadline to run at EDF_PRIORITY.
+ * @param   [in] PCB * server: process of interest
+ * @return  int: highest waiting priority, or -1 if none wait
+ */
+int inheritedPriority(PCB * server)
+{
+    PCB * process;
+    int highest = -1;
+    int waiting;
+
+    for(process = processList; process; process = process->nextProcess)
+    {
+        if(process->waitingOn == server && process->contents && process->priority > highest)
+        {
+            highest = process->priority;
+        }
+    }
+    waiting = mutexWaitingPriority(server);
+    highest = (waiting > highest) ? waiting : highest;
+    return (highest > HIGH_PRIORITY) ? HIGH_PRIORITY : highest;
+}
+
+/*
+ * @brief   Raises a server, and any server it in turn is blocked
+ *          waiting on or mutex holder it is queued behind, to the
+ *          priority of a blocked client or mutex waiter
+ * @param   [in/out] PCB * server: server the client waits on
+ *          [in] int priority: priority of the client
+ */
+void inheritPriority(PCB * server, int priority)
+{
+    int depth = 0;
+
+    priority = (priority > HIGH_PRIORITY) ? HIGH_PRIORITY : priority;
+    while(server && server->priority < priority && depth++ < INHERIT_DEPTH)
+    {
+        changePriority(server, priority);
+        /* Follow a server that is itself blocked on a reply or a mutex */
+        server = (server->contents) ? server->waitingOn :
+                 (server->waitingMutex) ? mutexRequeue(server) : NULL;
+    }
+}
+
+/*
+ * @brief   Called once a server has replied to a client: drops the
+ *          server back to the highest of its base priority and the
+ *          priorities of the clients still waiting on it
+ * @param   [in/out] PCB * server: server that replied
+ */
+void restorePriority(PCB * server)
+{
+    int waiting = inheritedPriority(server);
+
+    changePriority(server, (waiting > server->basePriority) ? waiting : server->basePriority);
+}
+
 /*
  * @brief   Configures pendSV interrupt by setting it to the lowest
  *          possible priority allowing other kernel calls to trigger
  *          the pendSV routine upon finishing their business.
+ *          SVCall and SysTick are set to KERNEL_IRQ_LEVEL so neither
+ *          preempts the other and zero-latency interrupts preempt both.
  */
 void initpendSV(void)
 {
     /* Set pendSV to lowest possible priority */
     SETPENDSVPRIORITY;
+    SETSVCPRIORITY;
+    SETSYSTICKPRIORITY;
 
     return;
 }
 
 
 /*
- * @brief   pendSV ISR that carries out context switches
+ * @brief   pendSV ISR that carries out context switches. Pended by
+ *          SysTick and by handlers posting with isrPost(): their posts
+ *          and expired timers are handled first, so a process they make
+ *          ready at a higher priority preempts. Once per tick, the tick
+ *          is then charged to budgets and, in MLFQ mode, the quantum.
+ *          Otherwise the interrupted process' queue is rotated. Only
+ *          kernel-aware interrupts are masked meanwhile.
  */
 void pendSV(void)
 {
-    disable();
+    PCB * interrupted;
+    int placed;
+
+    KERNEL_MASK();
     save_registers();
     RUNNING -> sp = get_PSP();
-    RUNNING = RUNNING -> next;
+    interrupted = RUNNING;
+    isrDrain();
+    if(sysTicks() != lastTick)
+    {
+        lastTick = sysTicks();
+        timerExpire(lastTick);
+        budgetTick(interrupted, lastTick);
+        placed = mlfqTick(interrupted, lastTick);
+        if(!placed && RUNNING == interrupted && RUNNING != RUNNING -> next)
+        {
+            RUNNING = RUNNING -> next;
+        }
+    }
+    if(RUNNING != interrupted)
+    {
+        accountSwitch(interrupted, RUNNING, FALSE);
+    }
     set_PSP(RUNNING -> sp);
     restore_registers();
-    enable();
-}
-
-/*
- * @brief   Entry point of SVC routine
- */
-void SVCall(void)
-{
-/* Supervisor call (trap) entry point
- * Using MSP - trapping process either MSP or PSP (specified in LR)
- * Source is specified in LR: F1 (MSP) or FD (PSP)
- * Save r4-r11 on trapping process stack (MSP or PSP)
- * Restore r4-r11 from trapping process stack to CPU
- * SVCHandler is called with r0 equal to MSP or PSP to access any arguments
- */
-
-/* Save LR for return via MSP or PSP */
-__asm("     PUSH    {LR}");
-
-/* Trapping source: MSP or PSP? */
-__asm("     TST     LR,#4");    /* Bit #3 (0100b) indicates MSP (0) or PSP (1) */
-__asm("     BNE     RtnViaPSP");
-
-/* Trapping source is MSP - save r4-r11 on stack (default, so just push) */
-__asm("     PUSH    {r4-r11}");
-__asm("     MRS r0,msp");
-__asm("     BL  SVCHandler");   /* r0 is MSP */
-__asm("     POP {r4-r11}");
-__asm("     POP     {PC}");
-
-/* Trapping source is PSP - save r4-r11 on psp stack (MSP is active stack) */
-__asm("RtnViaPSP:");
-__asm("     mrs     r0,psp");
-__asm("     stmdb   r0!,{r4-r11}"); /* Store multiple, decrement before */
-__asm("     msr psp,r0");
-__asm("     BL  SVCHandler");   /* r0 Is PSP */
-
-/* Restore r4..r11 from trapping process stack  */
-__asm("     mrs     r0,psp");
-__asm("     ldmia   r0!,{r4-r11}"); /* Load multiple, increment after */
-__asm("     msr psp,r0");
-__asm("     POP     {PC}");
-
+    KERNEL_UNMASK();
 }
 
-
-
-
-
 /*
  * @brief   Supervisor call handler
  *          Handle startup of initial process
@@ -258,15 +769,21 @@ void SVCHandler(StackFrame *argptr)
  * Argptr points to the full stack consisting of both hardware and software
    register pushes (i.e., R0..xPSR and R4..R10); this is defined in type
    stack_frame
- * Argptr is actually R0 -- setup in SVCall(), above.
+ * Argptr is actually R0 -- setup in SVCall() (Process.c).
  * Since this has been called as a trap (Cortex exception), the code is in
    Handler mode and uses the MSP
  */
 static int firstSVCcall = TRUE;
 KernelArgs *kcaptr;
 PCB * callerPCB;
+unsigned long code;
+int voluntary = FALSE;
+int waiting;
+unsigned long entryCycles;
 SendMessage * sendMsg;
 ReceiveMessage * recvMsg;
+MailBoxControl * mbControl;
+TimerStart * timerArgs;
 
 if (firstSVCcall)
 {
@@ -286,6 +803,8 @@ if (firstSVCcall)
     enable();     // Enable Master (CPU) Interrupts
 
     set_PSP(RUNNING-> sp + 8 * sizeof(unsigned int));
+    RUNNING -> switchedInAt = CYCLE_COUNT();
+    threadProcess = RUNNING;
 
     firstSVCcall = FALSE;
 
@@ -294,9 +813,7 @@ if (firstSVCcall)
      - Assembler required to change LR to FFFF.FFFD (Thread/PSP)
      - BX LR loads PC from PSP stack (also, R0 through xPSR) - "hard pull"
     */
-    __asm(" movw    LR,#0xFFFD");  /* Lower 16 [and clear top 16] */
-    __asm(" movt    LR,#0xFFFF");  /* Upper 16 only */
-    __asm(" bx  LR");          /* Force return to PSP */
+    RETURN_TO_PSP();
 }
 else /* Subsequent SVCs */
 {
@@ -311,60 +828,74 @@ else /* Subsequent SVCs */
    assigning the value of R7 (arptr -> r7) to kcaptr
  */
 
+    entryCycles = CYCLE_COUNT();
     kcaptr = (KernelArgs *) argptr -> r7;
-    switch(kcaptr -> code)
+    /* kcaptr is on the caller's stack, which TERMINATE frees */
+    code = kcaptr -> code;
+    callerPCB = RUNNING;
+    TRACE(TRACE_SVC, callerPCB -> pid, code);
+    switch(code)
     {
     case GETID:
         kcaptr -> rtnvalue = RUNNING -> pid;
     break;
     case NICE:
-        callerPCB = RUNNING;
-        kcaptr -> rtnvalue = addPCB(removePCB(),kcaptr->arg1);
-        /* Here, RUNNING has been changed to the PCB of the process that is to be
-         * run next. If RUNNING does not point to the process that requested a nice()
-         * then a context switch is required. Note that no registers are pushed/pulled
-         * because the caller's registers have been pushed prior to arriving here and
-         * the new RUNNING's registers will be pulled once this service call is concluded.
-         */
-        if(RUNNING != callerPCB)
+        /* EDF processes keep their class; their priority is returned unchanged */
+        if(IS_EDF(callerPCB))
         {
-            callerPCB -> sp = get_PSP();
-            set_PSP(RUNNING -> sp);
+            kcaptr -> rtnvalue = callerPCB->priority;
+            break;
         }
-
+        callerPCB->basePriority = kcaptr->arg1;
+        callerPCB->fixedPriority = kcaptr->arg1;
+        waiting = inheritedPriority(callerPCB);
+        addPCB(removePCB(), (waiting > (int)kcaptr->arg1) ? waiting : (int)kcaptr->arg1);
         /* Set the returned value to be the ending priority of the calling process */
         kcaptr -> rtnvalue = callerPCB->priority;
+        voluntary = TRUE;
     break;
     case SENDMSG:
-        callerPCB = RUNNING;
         sendMsg = (SendMessage *)kcaptr ->arg1;
-        kcaptr ->rtnvalue =
-                kernelSend(sendMsg->destinationMB,sendMsg->fromMB,
-                           sendMsg->contents, sendMsg->size);
-        if(RUNNING != callerPCB)
-        {
-            callerPCB -> sp = get_PSP();
-            set_PSP(RUNNING -> sp);
-        }
+        voluntary = kernelSend(sendMsg->destinationMB,sendMsg->fromMB,
+                               sendMsg->contents, sendMsg->size, &(kcaptr->rtnvalue));
     break;
     case RECEIVEMSG:
         recvMsg = (ReceiveMessage *)kcaptr ->arg1;
         kcaptr->rtnvalue = recvMsg->maxSize;
         if(kernelReceive(recvMsg->bindedMB,recvMsg->returnMB,
-                      recvMsg->contents, &(kcaptr->rtnvalue)) < 0)
+                      recvMsg->contents, &(kcaptr->rtnvalue), TRUE) < 0)
         {
             kcaptr->rtnvalue = FAILURE;
         }
+        voluntary = TRUE;
+    break;
+    case POLLMSG:
+        recvMsg = (ReceiveMessage *)kcaptr ->arg1;
+        kcaptr->rtnvalue = recvMsg->maxSize;
+        waiting = kernelReceive(recvMsg->bindedMB,recvMsg->returnMB,
+                                recvMsg->contents, &(kcaptr->rtnvalue), FALSE);
+        if(waiting < 0)
+        {
+            kcaptr->rtnvalue = (waiting == RECV_EMPTY) ? RECV_EMPTY : FAILURE;
+        }
     break;
     case TERMINATE:
+        freeProcessTimers(callerPCB);
+        budgetDetach(callerPCB);
+        rpcRelease(callerPCB);
+        if(IS_EDF(callerPCB))
+        {
+            edfCheckDeadline(callerPCB);
+            edfProcesses--;
+        }
         callerPCB = removePCB();
-        free(&(callerPCB->sp));
-        free(callerPCB);
-        /* RUNNING must have changed here so the process stack pointer must be
-         * changed accordingly. No registers are pulled here since they will all
-         * be pulled once this service call is exited.
-         */
-        set_PSP(RUNNING -> sp);
+        unlinkProcess(callerPCB);
+        mutexRelease(callerPCB);
+        kernelReleaseMailBoxes(callerPCB);
+        kernelExit(callerPCB, kcaptr->arg1);
+        /* Caller no longer exists so there is no context to save */
+        callerPCB = NULL;
+        voluntary = TRUE;
     break;
     case BIND:
         kcaptr->rtnvalue= kernelBind( kcaptr->arg1);
@@ -372,9 +903,127 @@ else /* Subsequent SVCs */
     case UNBIND:
         kcaptr->rtnvalue= kernelUnbind( kcaptr->arg1);
     break;
+    case GETSTATS:
+        kcaptr->rtnvalue= kernelProcessStats((ProcessStats *)kcaptr->arg1, kcaptr->arg2);
+    break;
+    case GETLATENCY:
+        kcaptr->rtnvalue= kernelLatency(kcaptr->arg1, (LatencyHistogram *)kcaptr->arg2);
+    break;
+    case GETMBSTATS:
+        kcaptr->rtnvalue= kernelMailBoxStats(kcaptr->arg1, (MailBoxStats *)kcaptr->arg2);
+    break;
+    case GETPOOLSTATS:
+        kcaptr->rtnvalue= kernelPoolStats((PoolStats *)kcaptr->arg1);
+    break;
+    case GETPROFILE:
+        kcaptr->rtnvalue= kernelProfile((ProfileWindow *)kcaptr->arg1);
+    break;
+    case WAITPERIOD:
+        kcaptr->rtnvalue= kernelWaitNextPeriod(callerPCB);
+        voluntary = TRUE;
+    break;
+    case TIMERSTART:
+        timerArgs = (TimerStart *)kcaptr->arg1;
+        kcaptr->rtnvalue= kernelTimerStart(callerPCB, timerArgs->MB, timerArgs->ticks, timerArgs->periodic);
+    break;
+    case TIMERCANCEL:
+        kcaptr->rtnvalue= kernelTimerCancel(callerPCB, kcaptr->arg1);
+    break;
+    case SCHEDMODE:
+        kcaptr->rtnvalue= kernelSchedulerMode(kcaptr->arg1);
+    break;
+    case SPAWN:
+        kcaptr->rtnvalue= kernelSpawn(callerPCB, (SpawnArgs *)kcaptr->arg1);
+    break;
+    case JOIN:
+        voluntary = kernelJoin(callerPCB, kcaptr->arg1, &(kcaptr->rtnvalue));
+    break;
+    case CHANNELBLOCK:
+        kcaptr->rtnvalue= kernelChannelBlock(callerPCB, (Channel *)kcaptr->arg1, kcaptr->arg2);
+        voluntary = (kcaptr->rtnvalue == TRUE);
+    break;
+    case CHANNELWAKE:
+        kcaptr->rtnvalue= kernelChannelWake((Channel *)kcaptr->arg1, kcaptr->arg2);
+    break;
+    case RPCCALL:
+        kcaptr->rtnvalue= kernelRpcSend(callerPCB, (RpcArgs *)kcaptr->arg1);
+        if(kcaptr->rtnvalue >= 0)
+        {
+            voluntary = kernelRpcWait(callerPCB, kcaptr->rtnvalue, ((RpcArgs *)kcaptr->arg1)->reply,
+                                      ((RpcArgs *)kcaptr->arg1)->maxSize, &(kcaptr->rtnvalue));
+        }
+    break;
+    case RPCSEND:
+        kcaptr->rtnvalue= kernelRpcSend(callerPCB, (RpcArgs *)kcaptr->arg1);
+    break;
+    case RPCWAIT:
+        voluntary = kernelRpcWait(callerPCB, ((RpcArgs *)kcaptr->arg1)->callId, ((RpcArgs *)kcaptr->arg1)->reply,
+                                  ((RpcArgs *)kcaptr->arg1)->maxSize, &(kcaptr->rtnvalue));
+    break;
+    case RPCREPLY:
+        kcaptr->rtnvalue= kernelRpcReply(callerPCB, ((RpcArgs *)kcaptr->arg1)->callId,
+                                         ((RpcArgs *)kcaptr->arg1)->contents, ((RpcArgs *)kcaptr->arg1)->size);
+    break;
+    case NAMEREGISTER:
+        kcaptr->rtnvalue= kernelNameRegister(callerPCB, (const char *)kcaptr->arg1, kcaptr->arg2);
+    break;
+    case NAMELOOKUP:
+        kcaptr->rtnvalue= kernelNameLookup((const char *)kcaptr->arg1);
+    break;
+    case GETIRQLATENCY:
+        kcaptr->rtnvalue= kernelIrqLatency(kcaptr->arg1, (LatencyHistogram *)kcaptr->arg2);
+    break;
+    case MBCONTROL:
+        mbControl = (MailBoxControl *)kcaptr->arg1;
+        kcaptr->rtnvalue= kernelMailBoxControl(mbControl->MB, mbControl->option, mbControl->value);
+    break;
+    case EVENTSET:
+        kcaptr->rtnvalue= kernelEventSet(kcaptr->arg1, kcaptr->arg2);
+    break;
+    case EVENTWAIT:
+        voluntary = kernelEventWait(callerPCB, (EventWait *)kcaptr->arg1, &(kcaptr->rtnvalue));
+    break;
+    case SEMBLOCK:
+        kcaptr->rtnvalue= kernelSemaphoreBlock(callerPCB, (Semaphore *)kcaptr->arg1);
+        voluntary = (kcaptr->rtnvalue == TRUE);
+    break;
+    case SEMWAKE:
+        kcaptr->rtnvalue= kernelSemaphoreWake((Semaphore *)kcaptr->arg1);
+    break;
+    case MUTEXBLOCK:
+        kcaptr->rtnvalue= kernelMutexBlock(callerPCB, (Mutex *)kcaptr->arg1);
+        voluntary = (kcaptr->rtnvalue == TRUE);
+    break;
+    case MUTEXWAKE:
+        kcaptr->rtnvalue= kernelMutexWake(callerPCB, (Mutex *)kcaptr->arg1);
+    break;
     default:
         kcaptr -> rtnvalue = -1;
     }
+
+    /* Here, RUNNING has been changed to the PCB of the process that is to be
+     * run next. If RUNNING does not point to the process that made the kernel
+     * call then a context switch is required. Note that no registers are pushed/pulled
+     * because the caller's registers have been pushed prior to arriving here and
+     * the new RUNNING's registers will be pulled once this service call is concluded.
+     */
+    if(RUNNING != callerPCB)
+    {
+        if(callerPCB)
+        {
+            callerPCB -> sp = get_PSP();
+        }
+        /* Blocking, exiting or lowering its own priority gives up the CPU;
+         * any other switch (e.g. a send waking a higher priority receiver)
+         * is a preemption */
+        accountSwitch(callerPCB, RUNNING, voluntary);
+        set_PSP(RUNNING -> sp);
+    }
+
+    if(code < KERNEL_CALL_CODES)
+    {
+        latencyRecord(&callLatency[code], CYCLE_COUNT() - entryCycles);
+    }
 }
 }
 
@@ -8,17 +8,37 @@
  */
 #pragma once
 #include "Process.h"
+#include "Hardware.h"
+#include "Interrupts.h"
+
+struct LatencyHistogram_;
+
 /* Macro used to set the priority of the pendSV interrupt */
-#define SETPENDSVPRIORITY ((*(volatile unsigned long *)0xE000ED20) |= 0x00E00000UL)
+#define SETPENDSVPRIORITY (HW_REGISTER(0xE000ED20) |= 0x00E00000UL)
+/* Macros used to run SVCall and SysTick at the most urgent kernel-aware level */
+#define SETSVCPRIORITY (HW_REGISTER(0xE000ED1C) = IRQ_PRIORITY(KERNEL_IRQ_LEVEL) << 24)
+#define SETSYSTICKPRIORITY (HW_REGISTER(0xE000ED20) = \
+    (HW_REGISTER(0xE000ED20) & 0x00FFFFFFUL) | (IRQ_PRIORITY(KERNEL_IRQ_LEVEL) << 24))
 
 #ifndef GLOBAL_SVC
 #define GLOBAL_SVC
 
 extern int registerProcess(void (*)(void), unsigned int,int );
+extern int registerEDFProcess(void (*)(void), unsigned int, unsigned long, unsigned long);
+extern int registerTimedProcess(void (*)(void), unsigned int, int, unsigned long, unsigned long, unsigned long);
 extern int addPCB(PCB *,int);
 extern PCB * removePCB(void);
 extern void initpendSV(void);
 extern PCB * getRunningPCB(void);
+extern PCB * getThreadProcess(void);
+extern PCB * findProcess(unsigned int);
+extern PCB * getProcessList(void);
+extern PCB * createProcess(void (*)(void), unsigned int, int, unsigned long);
+extern void unlinkPCB(PCB *);
+extern void changePriority(PCB *, int);
+extern int inheritedPriority(PCB *);
+extern void inheritPriority(PCB *, int);
+extern void restorePriority(PCB *);
 
 #else
 
@@ -26,7 +46,8 @@ void decrementPriority(void);
 int addPCB(PCB *, int);
 PCB * removePCB(void);
 void initpendSV(void);
-void SVCall(void);
 void SVCHandler(StackFrame*);
+int kernelProcessStats(ProcessStats *, int);
+int kernelLatency(unsigned long, struct LatencyHistogram_ *);
 
 #endif /* GLOBAL_SVC */
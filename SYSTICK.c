@@ -10,9 +10,14 @@
  */
 #define GLOBAL_SYSTICK
 #include "SYSTICK.h"
+#include "Profile.h"
+#include "EDF.h"
 
 /* Macro used to request a pendSV call */
-#define CALLPENDSV (*((volatile unsigned long *)0xE000ED04) |= 0x10000000UL)
+#define CALLPENDSV (HW_REGISTER(0xE000ED04) |= 0x10000000UL)
+
+/* SysTick interrupts since start, the time base of EDF deadlines */
+PRIVATE volatile unsigned long ticks = 0;
 
 /*
  * @brief   Set the clock source to internal and enable the counter to interrupt
@@ -59,12 +64,26 @@ void SysTickIntDisable(void)
 ST_CTRL_R &= ~(ST_CTRL_INTEN);
 }
 
+/*
+ * @brief   Number of SysTick interrupts since start
+ * @return  unsigned long: current tick
+ */
+unsigned long sysTicks(void)
+{
+    return ticks;
+}
+
 /*
  * @brief ISR of SYSTICK requesting a context switch
  *
  */
 void SYSTICKHandler(void)
 {
+    PROFILE_SAMPLE();
+
+    ticks++;
+    edfTick();
+
     /* Request a pendSV call */
     CALLPENDSV;
 }
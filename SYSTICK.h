@@ -10,10 +10,11 @@
  */
 
 #pragma once
+#include "Hardware.h"
 
-#define ST_CTRL_R   (*((volatile unsigned long *)0xE000E010))
+#define ST_CTRL_R   HW_REGISTER(0xE000E010)
 // Systick Reload Value Register (STRELOAD)
-#define ST_RELOAD_R (*((volatile unsigned long *)0xE000E014))
+#define ST_RELOAD_R HW_REGISTER(0xE000E014)
 
 // SysTick defines
 #define ST_CTRL_COUNT      0x00010000  // Count Flag for STCTRL
@@ -33,6 +34,7 @@
     extern void SysTickPeriod(unsigned long);
     extern void SysTickIntEnable(void);
     extern void SysTickIntDisable(void);
-    extern void SysTickHandler(void);
+    extern void SYSTICKHandler(void);
+    extern unsigned long sysTicks(void);
 
 #endif //GLOBAL_SYSTICK
@@ -0,0 +1,287 @@
+/*
+ * @file    Spawn.c
+ * @brief   Contains the PCB and stack pools and the kernel side of
+ *          spawn(), exitProcess() and join()
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_SPAWN
+#include "Spawn.h"
+#include "SVC.h"
+#include "DWT.h"
+#include "Utilities.h"
+
+PRIVATE PCB * freePCBs = NULL;
+PRIVATE unsigned long * freeLargeStacks = NULL;
+PRIVATE unsigned long * freeSmallStacks = NULL;
+/* Exited spawned processes not yet joined, linked through nextProcess */
+PRIVATE PCB * zombieList = NULL;
+PRIVATE unsigned int nextPid = SPAWN_FIRST_PID;
+
+/*
+ * @brief   Allocates every PCB and stack processes will use. Called
+ *          from main() before any process is registered.
+ */
+void initProcessPool(void)
+{
+    PCB * pcb;
+    unsigned long * stack;
+    int i;
+
+    for(i = 0; i < PROCESS_AMOUNT; i++)
+    {
+        pcb = (PCB *)malloc(sizeof(PCB));
+        pcb->nextProcess = freePCBs;
+        freePCBs = pcb;
+    }
+    for(i = 0; i < LARGE_STACKS; i++)
+    {
+        stack = (unsigned long *)malloc(LARGE_STACK_WORDS * sizeof(unsigned long));
+        *stack = (unsigned long)freeLargeStacks;
+        freeLargeStacks = stack;
+    }
+    for(i = 0; i < SMALL_STACKS; i++)
+    {
+        stack = (unsigned long *)malloc(SMALL_STACK_WORDS * sizeof(unsigned long));
+        *stack = (unsigned long)freeSmallStacks;
+        freeSmallStacks = stack;
+    }
+}
+
+/*
+ * @brief   Takes a stack from a class' free list, its first word
+ *          linking the next free stack
+ * @param   [in/out] unsigned long ** freeList: free list of the class
+ * @return  unsigned long *: the stack, NULL if none is free
+ */
+PRIVATE unsigned long * takeStack(unsigned long ** freeList)
+{
+    unsigned long * stack = *freeList;
+
+    if(stack)
+    {
+        *freeList = (unsigned long *)*stack;
+    }
+    return stack;
+}
+
+/*
+ * @brief   Takes a PCB and the smallest free stack of at least stackSize
+ *          bytes from the pools. Sets topOfStack and stackSize.
+ * @param   [in] unsigned long stackSize: bytes of stack wanted
+ * @return  PCB *: the PCB, NULL if none or no large enough stack is free
+ */
+PCB * allocProcess(unsigned long stackSize)
+{
+    PCB * pcb = freePCBs;
+    unsigned long * stack = NULL;
+
+    if(!pcb || stackSize > LARGE_STACK_WORDS * sizeof(unsigned long))
+    {
+        return NULL;
+    }
+
+    if(stackSize <= SMALL_STACK_WORDS * sizeof(unsigned long))
+    {
+        stack = takeStack(&freeSmallStacks);
+        stackSize = SMALL_STACK_WORDS * sizeof(unsigned long);
+    }
+    if(!stack)
+    {
+        stack = takeStack(&freeLargeStacks);
+        stackSize = LARGE_STACK_WORDS * sizeof(unsigned long);
+    }
+    if(!stack)
+    {
+        return NULL;
+    }
+
+    freePCBs = pcb->nextProcess;
+    pcb->topOfStack = (unsigned long)stack;
+    pcb->stackSize = stackSize;
+    return pcb;
+}
+
+/*
+ * @brief   Returns a process' stack to its class
+ * @param   [in/out] PCB * pcb: process whose stack is released
+ */
+PRIVATE void freeStack(PCB * pcb)
+{
+    unsigned long * stack = (unsigned long *)pcb->topOfStack;
+    unsigned long ** freeList = (pcb->stackSize == SMALL_STACK_WORDS * sizeof(unsigned long)) ?
+                                &freeSmallStacks : &freeLargeStacks;
+
+    if(stack)
+    {
+        *stack = (unsigned long)*freeList;
+        *freeList = stack;
+        pcb->topOfStack = 0;
+    }
+}
+
+/*
+ * @brief   Returns a PCB, and its stack if still held, to the pools
+ * @param   [in/out] PCB * pcb: process released
+ */
+PRIVATE void freeProcess(PCB * pcb)
+{
+    freeStack(pcb);
+    pcb->nextProcess = freePCBs;
+    freePCBs = pcb;
+}
+
+/*
+ * @brief   Finds an unused pid for a spawned process
+ * @return  unsigned int: the pid
+ */
+PRIVATE unsigned int spawnPid(void)
+{
+    PCB * zombie;
+    int inUse;
+
+    do
+    {
+        inUse = (findProcess(nextPid) != NULL);
+        for(zombie = zombieList; zombie && !inUse; zombie = zombie->nextProcess)
+        {
+            inUse = (zombie->pid == nextPid);
+        }
+        nextPid = (nextPid + 1 < SPAWN_FIRST_PID) ? SPAWN_FIRST_PID : nextPid + 1;
+    } while(inUse);
+
+    return nextPid - 1;
+}
+
+/*
+ * @brief   Creates a child of the running process and makes it ready.
+ *          A child of higher priority than its parent runs at once.
+ * @param   [in/out] PCB * parent: process calling spawn()
+ *          [in] SpawnArgs * args: entry, priority, stack size and argument
+ * @return  int: pid of the child; -1 -> invalid priority, or no PCB
+ *               or stack of that size is free
+ */
+int kernelSpawn(PCB * parent, SpawnArgs * args)
+{
+    PCB * child;
+    StackFrame * frame;
+
+    if(args->priority < 0 || args->priority >= PRIORITY_LEVELS)
+    {
+        return FAILURE;
+    }
+
+    child = createProcess((void (*)(void))args->entry, spawnPid(),
+                          args->priority, args->stackSize);
+    if(!child)
+    {
+        return FAILURE;
+    }
+
+    frame = (StackFrame *)child->sp;
+    frame->r0 = (unsigned long)args->arg;
+    child->parent = parent;
+    addPCB(child, args->priority);
+    return child->pid;
+}
+
+/*
+ * @brief   Collects the exit code of a child, blocking the caller until
+ *          the child exits if it is still running
+ * @param   [in/out] PCB * caller: process calling join()
+ *          [in] int pid: pid of one of its children
+ *          [out] int * returnValue: receives the exit code, now or when
+ *                the child exits; JOIN_FAIL if pid is not a child
+ * @return  int: TRUE if the caller blocked
+ */
+int kernelJoin(PCB * caller, int pid, int * returnValue)
+{
+    PCB ** link = &zombieList;
+    PCB * child;
+
+    while(*link && ((*link)->pid != pid || (*link)->parent != caller))
+    {
+        link = &((*link)->nextProcess);
+    }
+
+    if(*link)
+    {
+        child = *link;
+        *link = child->nextProcess;
+        *returnValue = child->exitCode;
+        freeProcess(child);
+        return FALSE;
+    }
+
+    child = findProcess(pid);
+    if(!child || child->parent != caller)
+    {
+        *returnValue = JOIN_FAIL;
+        return FALSE;
+    }
+
+    removePCB();
+    caller->joining = child;
+    caller->returnValue = returnValue;
+    caller->blockedAt = CYCLE_COUNT();
+    return TRUE;
+}
+
+/*
+ * @brief   Completes the exit of a process already removed from the
+ *          queues and the process list: orphans its children, then
+ *          hands its code to a parent blocked in join() or keeps it as
+ *          a zombie until joined. Processes nobody can join are freed.
+ * @param   [in/out] PCB * process: process exiting
+ *          [in] int code: its exit code
+ */
+void kernelExit(PCB * process, int code)
+{
+    PCB ** link = &zombieList;
+    PCB * other;
+    PCB * parent = process->parent;
+
+    /* Children still running are reclaimed when they exit */
+    for(other = getProcessList(); other; other = other->nextProcess)
+    {
+        if(other->parent == process)
+        {
+            other->parent = NULL;
+        }
+    }
+    while(*link)
+    {
+        other = *link;
+        if(other->parent == process)
+        {
+            *link = other->nextProcess;
+            freeProcess(other);
+        }
+        else
+        {
+            link = &(other->nextProcess);
+        }
+    }
+
+    if(!parent)
+    {
+        freeProcess(process);
+    }
+    else if(parent->joining == process)
+    {
+        *(parent->returnValue) = code;
+        parent->joining = NULL;
+        parent->blockedCycles += CYCLE_COUNT() - parent->blockedAt;
+        addPCB(parent, parent->priority);
+        freeProcess(process);
+    }
+    else
+    {
+        /* Only the exit code is needed from here on */
+        freeStack(process);
+        process->exitCode = code;
+        process->nextProcess = zombieList;
+        zombieList = process;
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * @file    Spawn.h
+ * @brief   Process pool and runtime process creation.
+ *          Every PCB and stack comes from pools allocated once by
+ *          initProcessPool(), so registering, spawning and exiting
+ *          processes never fragments the heap. Stacks come in two
+ *          classes; a process gets the smallest that holds the stack
+ *          size it asked for.
+ *          A running process may spawn() a child, which runs until it
+ *          returns or calls exitProcess(code). The parent collects the
+ *          code with join(pid), blocking until the child has exited;
+ *          an exited child keeps only its PCB, as a zombie, until then.
+ *          Children left when their parent exits are reclaimed as soon
+ *          as they exit.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Process.h"
+
+/* PCBs shared by registered and spawned processes */
+#define PROCESS_AMOUNT      16
+/* Stack classes, in words */
+#define LARGE_STACK_WORDS   1024
+#define SMALL_STACK_WORDS   256
+#define LARGE_STACKS        11
+#define SMALL_STACKS        8
+/* Stack size registerProcess() asks for, in bytes */
+#define DEFAULT_STACK_SIZE  (LARGE_STACK_WORDS * sizeof(unsigned long))
+/* Pids given to spawned processes start here */
+#define SPAWN_FIRST_PID     100
+
+/*
+ * @brief   Spawn Argument Structure
+ * @details Arguments of spawn() passed to the kernel
+ */
+typedef struct SpawnArgs_
+{
+    void (*entry)(void *);//code of the child
+    int priority;//LOW_PRIORITY to HIGH_PRIORITY
+    unsigned long stackSize;//bytes, at most DEFAULT_STACK_SIZE
+    void * arg;//passed to entry
+}SpawnArgs;
+
+#ifndef GLOBAL_SPAWN
+#define GLOBAL_SPAWN
+
+extern void initProcessPool(void);
+extern PCB * allocProcess(unsigned long);
+extern int kernelSpawn(PCB *, SpawnArgs *);
+extern int kernelJoin(PCB *, int, int *);
+extern void kernelExit(PCB *, int);
+
+#endif /* GLOBAL_SPAWN */
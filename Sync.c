@@ -0,0 +1,420 @@
+/*
+ * @file    Sync.c
+ * @brief   Contains the thread mode semaphore and mutex operations and
+ *          the kernel side of blocking, waking and priority inheritance
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_SYNC
+#include "Sync.h"
+#include "KernelCall.h"
+#include "SVC.h"
+#include "MLFQ.h"
+#include "DWT.h"
+#include "Utilities.h"
+
+/* Holder of a mutex, without MUTEX_WAITERS */
+#define MUTEX_HOLDER(mutex) ((PCB *)((mutex)->owner & ~MUTEX_WAITERS))
+
+/*
+ * @brief   Adds to a semaphore count with compare-and-swap
+ * @param   [in/out] volatile long * count: count changed
+ *          [in] long delta: amount added
+ * @return  long: the new count
+ */
+PRIVATE long semAdd(volatile long * count, long delta)
+{
+    long old;
+
+    do
+    {
+        old = *count;
+    } while(!COMPARE_AND_SWAP((volatile unsigned long *)count, (unsigned long)old,
+                              (unsigned long)(old + delta)));
+    return old + delta;
+}
+
+/*
+ * @brief   Prepares a semaphore. Called before any process uses it.
+ * @param   [out] Semaphore * semaphore: semaphore to initialize
+ *          [in] long count: units initially available
+ */
+void semInit(Semaphore * semaphore, long count)
+{
+    semaphore->count = count;
+    semaphore->wakeups = 0;
+    semaphore->waiters = NULL;
+}
+
+/*
+ * @brief   Takes a unit, blocking until one is signalled if none is
+ *          available
+ * @param   [in/out] Semaphore * semaphore: semaphore taken from
+ * @return  int: SUCCESS
+ */
+int semWait(Semaphore * semaphore)
+{
+    if(semAdd(&semaphore->count, -1) < 0)
+    {
+        semaphoreBlock(semaphore);
+    }
+    return SUCCESS;
+}
+
+/*
+ * @brief   Takes a unit if one is available, never blocking
+ * @param   [in/out] Semaphore * semaphore: semaphore taken from
+ * @return  int: SUCCESS; FAILURE if none is available
+ */
+int semTryWait(Semaphore * semaphore)
+{
+    long count;
+
+    do
+    {
+        count = semaphore->count;
+        if(count <= 0)
+        {
+            return FAILURE;
+        }
+    } while(!COMPARE_AND_SWAP((volatile unsigned long *)&semaphore->count, (unsigned long)count,
+                              (unsigned long)(count - 1)));
+    return SUCCESS;
+}
+
+/*
+ * @brief   Gives a unit, waking the first waiter if there is one
+ * @param   [in/out] Semaphore * semaphore: semaphore given to
+ * @return  int: SUCCESS
+ */
+int semSignal(Semaphore * semaphore)
+{
+    if(semAdd(&semaphore->count, 1) <= 0)
+    {
+        semaphoreWake(semaphore);
+    }
+    return SUCCESS;
+}
+
+/*
+ * @brief   Prepares an unlocked mutex. Called before any process uses it.
+ * @param   [out] Mutex * mutex: mutex to initialize
+ */
+void mutexInit(Mutex * mutex)
+{
+    mutex->owner = MUTEX_FREE;
+    mutex->waiters = NULL;
+    mutex->nextHeld = NULL;
+}
+
+/*
+ * @brief   Locks a mutex, blocking until its holder hands it over if
+ *          it is held
+ * @param   [in/out] Mutex * mutex: mutex locked
+ * @return  int: SUCCESS; FAILURE if the caller already holds it
+ */
+int mutexLock(Mutex * mutex)
+{
+    if(COMPARE_AND_SWAP(&mutex->owner, MUTEX_FREE, (unsigned long)getThreadProcess()))
+    {
+        return SUCCESS;
+    }
+    return (mutexBlock(mutex) == FAILURE) ? FAILURE : SUCCESS;
+}
+
+/*
+ * @brief   Locks a mutex if it is free, never blocking
+ * @param   [in/out] Mutex * mutex: mutex locked
+ * @return  int: SUCCESS; FAILURE if it is held
+ */
+int mutexTryLock(Mutex * mutex)
+{
+    return COMPARE_AND_SWAP(&mutex->owner, MUTEX_FREE, (unsigned long)getThreadProcess()) ?
+           SUCCESS : FAILURE;
+}
+
+/*
+ * @brief   Unlocks a mutex held by the caller, handing it to its first
+ *          waiter if it has any
+ * @param   [in/out] Mutex * mutex: mutex unlocked
+ * @return  int: SUCCESS; FAILURE if the caller does not hold it
+ */
+int mutexUnlock(Mutex * mutex)
+{
+    if(COMPARE_AND_SWAP(&mutex->owner, (unsigned long)getThreadProcess(), MUTEX_FREE))
+    {
+        return SUCCESS;
+    }
+    return mutexWake(mutex);
+}
+
+/*
+ * @brief   Inserts a process into a wait queue after every waiter of
+ *          its priority or higher
+ * @param   [in/out] PCB ** queue: first waiter
+ *          [in/out] PCB * process: process queued
+ */
+PRIVATE void waiterInsert(PCB ** queue, PCB * process)
+{
+    while(*queue && (*queue)->priority >= process->priority)
+    {
+        queue = &((*queue)->nextWaiter);
+    }
+    process->nextWaiter = *queue;
+    *queue = process;
+}
+
+/*
+ * @brief   Removes a process from a wait queue if it is there
+ * @param   [in/out] PCB ** queue: first waiter
+ *          [in/out] PCB * process: process removed
+ */
+PRIVATE void waiterRemove(PCB ** queue, PCB * process)
+{
+    while(*queue && *queue != process)
+    {
+        queue = &((*queue)->nextWaiter);
+    }
+    if(*queue)
+    {
+        *queue = process->nextWaiter;
+        process->nextWaiter = NULL;
+    }
+}
+
+/*
+ * @brief   Takes the first waiter off a wait queue and makes it ready
+ * @param   [in/out] PCB ** queue: first waiter, not NULL
+ * @return  PCB *: the waiter woken
+ */
+PRIVATE PCB * waiterWake(PCB ** queue)
+{
+    PCB * waiter = *queue;
+
+    *queue = waiter->nextWaiter;
+    waiter->nextWaiter = NULL;
+    waiter->blockedCycles += CYCLE_COUNT() - waiter->blockedAt;
+    return waiter;
+}
+
+/*
+ * @brief   Removes the RUNNING process from the queues and queues it
+ *          on a semaphore or mutex
+ * @param   [in/out] PCB * caller: the RUNNING process
+ *          [in/out] PCB ** queue: wait queue joined
+ */
+PRIVATE void waiterBlock(PCB * caller, PCB ** queue)
+{
+    removePCB();
+    caller->blockedAt = CYCLE_COUNT();
+    waiterInsert(queue, caller);
+    mlfqBlock(caller);
+}
+
+/*
+ * @brief   Blocks the caller of semWait() that took a semaphore's count
+ *          below zero, unless its signal has already been given
+ * @param   [in/out] PCB * caller: the RUNNING process
+ *          [in/out] Semaphore * semaphore: semaphore waited on
+ * @return  int: TRUE if the caller blocked
+ */
+int kernelSemaphoreBlock(PCB * caller, Semaphore * semaphore)
+{
+    if(semaphore->wakeups)
+    {
+        semaphore->wakeups--;
+        return FALSE;
+    }
+
+    caller->waitingSemaphore = semaphore;
+    waiterBlock(caller, &semaphore->waiters);
+    return TRUE;
+}
+
+/*
+ * @brief   Wakes the first waiter of a semaphore, or keeps the signal
+ *          for a waiter that has not blocked yet
+ * @param   [in/out] Semaphore * semaphore: semaphore signalled
+ * @return  int: SUCCESS
+ */
+int kernelSemaphoreWake(Semaphore * semaphore)
+{
+    PCB * waiter;
+
+    if(!semaphore->waiters)
+    {
+        semaphore->wakeups++;
+        return SUCCESS;
+    }
+
+    waiter = waiterWake(&semaphore->waiters);
+    waiter->waitingSemaphore = NULL;
+    addPCB(waiter, waiter->priority);
+    return SUCCESS;
+}
+
+/*
+ * @brief   Removes a mutex from its holder's list of mutexes with waiters
+ * @param   [in/out] PCB * holder: holder of the mutex
+ *          [in] Mutex * mutex: mutex removed
+ */
+PRIVATE void heldRemove(PCB * holder, Mutex * mutex)
+{
+    Mutex ** link = &holder->mutexesHeld;
+
+    while(*link && *link != mutex)
+    {
+        link = &((*link)->nextHeld);
+    }
+    if(*link)
+    {
+        *link = mutex->nextHeld;
+        mutex->nextHeld = NULL;
+    }
+}
+
+/*
+ * @brief   Passes a mutex its holder has given up to its first waiter,
+ *          which inherits the priority of any waiters left, or unlocks
+ *          it if none wait
+ * @param   [in/out] Mutex * mutex: mutex already removed from its
+ *          holder's list
+ */
+PRIVATE void mutexHandOver(Mutex * mutex)
+{
+    PCB * next;
+
+    if(!mutex->waiters)
+    {
+        mutex->owner = MUTEX_FREE;
+        return;
+    }
+
+    next = waiterWake(&mutex->waiters);
+    next->waitingMutex = NULL;
+    mutex->owner = (unsigned long)next;
+    if(mutex->waiters)
+    {
+        mutex->owner |= MUTEX_WAITERS;
+        mutex->nextHeld = next->mutexesHeld;
+        next->mutexesHeld = mutex;
+    }
+    addPCB(next, next->priority);
+    if(mutex->waiters)
+    {
+        inheritPriority(next, mutex->waiters->priority);
+    }
+}
+
+/*
+ * @brief   Takes a mutex for the caller of mutexLock() if it has been
+ *          unlocked meanwhile, else queues the caller on it and lends
+ *          the caller's priority to the holder
+ * @param   [in/out] PCB * caller: the RUNNING process
+ *          [in/out] Mutex * mutex: mutex locked
+ * @return  int: TRUE if the caller blocked; FALSE if it took the mutex;
+ *               FAILURE if it already holds it
+ */
+int kernelMutexBlock(PCB * caller, Mutex * mutex)
+{
+    PCB * holder = MUTEX_HOLDER(mutex);
+
+    if(!holder)
+    {
+        mutex->owner = (unsigned long)caller;
+        return FALSE;
+    }
+    if(holder == caller)
+    {
+        return FAILURE;
+    }
+
+    if(!(mutex->owner & MUTEX_WAITERS))
+    {
+        mutex->owner |= MUTEX_WAITERS;
+        mutex->nextHeld = holder->mutexesHeld;
+        holder->mutexesHeld = mutex;
+    }
+    caller->waitingMutex = mutex;
+    waiterBlock(caller, &mutex->waiters);
+    inheritPriority(holder, caller->priority);
+    return TRUE;
+}
+
+/*
+ * @brief   Unlocks a mutex with waiters for the caller of mutexUnlock():
+ *          the caller drops back to the priority it has without the
+ *          mutex's waiters and the first of them takes the mutex
+ * @param   [in/out] PCB * caller: the RUNNING process
+ *          [in/out] Mutex * mutex: mutex unlocked
+ * @return  int: SUCCESS; FAILURE if the caller does not hold it
+ */
+int kernelMutexWake(PCB * caller, Mutex * mutex)
+{
+    if(MUTEX_HOLDER(mutex) != caller)
+    {
+        return FAILURE;
+    }
+
+    heldRemove(caller, mutex);
+    restorePriority(caller);
+    mutexHandOver(mutex);
+    return SUCCESS;
+}
+
+/*
+ * @brief   Finds the highest priority waiting on the mutexes a
+ *          process holds. Called by inheritedPriority().
+ * @param   [in] PCB * holder: process of interest
+ * @return  int: highest waiting priority, or -1 if none wait
+ */
+int mutexWaitingPriority(PCB * holder)
+{
+    Mutex * mutex;
+    int highest = -1;
+
+    for(mutex = holder->mutexesHeld; mutex; mutex = mutex->nextHeld)
+    {
+        /* Queues are in priority order */
+        if(mutex->waiters->priority > highest)
+        {
+            highest = mutex->waiters->priority;
+        }
+    }
+    return highest;
+}
+
+/*
+ * @brief   Moves a mutex waiter whose priority has been raised up its
+ *          queue. Called by inheritPriority() to follow a chain of
+ *          holders.
+ * @param   [in/out] PCB * waiter: process blocked in mutexLock()
+ * @return  PCB *: holder of the mutex it waits on
+ */
+PCB * mutexRequeue(PCB * waiter)
+{
+    Mutex * mutex = waiter->waitingMutex;
+
+    waiterRemove(&mutex->waiters, waiter);
+    waiterInsert(&mutex->waiters, waiter);
+    return MUTEX_HOLDER(mutex);
+}
+
+/*
+ * @brief   Hands each mutex a terminating process holds with waiters to
+ *          the first of them. Called once it is off the queues.
+ * @param   [in/out] PCB * process: process terminating
+ */
+void mutexRelease(PCB * process)
+{
+    Mutex * mutex;
+
+    while(process->mutexesHeld)
+    {
+        mutex = process->mutexesHeld;
+        process->mutexesHeld = mutex->nextHeld;
+        mutex->nextHeld = NULL;
+        mutexHandOver(mutex);
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * @file    Sync.h
+ * @brief   Counting semaphores and mutexes.
+ *          A Semaphore or Mutex lives in memory its processes can
+ *          reach, like a Channel. Taking or giving one that nobody is
+ *          waiting on is a compare-and-swap in thread mode (LDREX/STREX,
+ *          Hardware.h), so it never traps; the kernel is entered only
+ *          to block a process and to wake one:
+ *              - a semaphore's count goes below zero by the number of
+ *                processes waiting or about to. semWait() blocks when
+ *                it takes the count below zero and semSignal() wakes a
+ *                waiter when it finds it there. A signal reaching the
+ *                kernel before its waiter has blocked is kept, and the
+ *                waiter does not block.
+ *              - a mutex holds its holder's PCB, with MUTEX_WAITERS set
+ *                by the kernel once a process waits on it, so the
+ *                holder's unlock enters the kernel to hand it over.
+ *                The holder inherits the priority of its highest
+ *                waiter until it unlocks, following a holder that is
+ *                itself waiting on a mutex or a reply (SVC.c).
+ *          Waiters are queued through their PCBs, highest priority
+ *          first and in arrival order among equals; a mutex waiter
+ *          raised by inheritance moves up its queue.
+ *          A process that ends holding a mutex others wait on passes it
+ *          to the first of them; one nobody waits on stays locked.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Process.h"
+
+/* Mutex owner bit set while processes wait on it; PCBs are word aligned */
+#define MUTEX_WAITERS       0x1UL
+#define MUTEX_FREE          0UL
+
+/*
+ * @brief   Semaphore Structure
+ * @details count is updated in thread mode; the rest only by the kernel
+ */
+typedef struct Semaphore_
+{
+    volatile long count;//units available, or minus the processes waiting
+    int wakeups;//kernel: signals given before their waiter blocked
+    PCB * waiters;//kernel: blocked processes, linked through nextWaiter
+}Semaphore;
+
+/*
+ * @brief   Mutex Structure
+ * @details owner is set in thread mode while uncontended; the rest
+ *          only by the kernel
+ */
+typedef struct Mutex_
+{
+    volatile unsigned long owner;//holder's PCB | MUTEX_WAITERS, MUTEX_FREE if unlocked
+    PCB * waiters;//kernel: blocked processes, linked through nextWaiter
+    struct Mutex_ * nextHeld;//kernel: next mutex with waiters of the same holder
+}Mutex;
+
+#ifndef GLOBAL_SYNC
+#define GLOBAL_SYNC
+
+extern void semInit(Semaphore *, long);
+extern int semWait(Semaphore *);
+extern int semTryWait(Semaphore *);
+extern int semSignal(Semaphore *);
+extern void mutexInit(Mutex *);
+extern int mutexLock(Mutex *);
+extern int mutexTryLock(Mutex *);
+extern int mutexUnlock(Mutex *);
+extern int kernelSemaphoreBlock(PCB *, Semaphore *);
+extern int kernelSemaphoreWake(Semaphore *);
+extern int kernelMutexBlock(PCB *, Mutex *);
+extern int kernelMutexWake(PCB *, Mutex *);
+extern int mutexWaitingPriority(PCB *);
+extern PCB * mutexRequeue(PCB *);
+extern void mutexRelease(PCB *);
+
+#endif /* GLOBAL_SYNC */
@@ -0,0 +1,312 @@
+/*
+ * @file    Timer.c
+ * @brief   Contains the sorted list of armed kernel timers, periodic
+ *          process release and software timers
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_TIMER
+#include "Timer.h"
+#include "EDF.h"
+#include "SVC.h"
+#include "SYSTICK.h"
+#include "Messages.h"
+#include "Utilities.h"
+#include "DWT.h"
+#include "Events.h"
+
+PRIVATE Timer timers[TIMER_AMOUNT];
+/* Unused timers, linked through next */
+PRIVATE Timer * freeTimers = NULL;
+/* Armed timers, earliest expiry first */
+PRIVATE Timer * armed = NULL;
+
+/*
+ * @brief   Puts every timer in the free list
+ */
+void initTimers(void)
+{
+    int i;
+
+    armed = NULL;
+    freeTimers = NULL;
+    for(i = TIMER_AMOUNT - 1; i >= 0; i--)
+    {
+        timers[i].owner = NULL;
+        timers[i].next = freeTimers;
+        freeTimers = &timers[i];
+    }
+}
+
+/*
+ * @brief   Takes a timer from the free list
+ * @param   [in] PCB * owner: process the timer belongs to
+ * @return  Timer *: the timer, NULL if none are free
+ */
+PRIVATE Timer * timerAllocate(PCB * owner)
+{
+    Timer * timer = freeTimers;
+
+    if(timer)
+    {
+        freeTimers = timer->next;
+        timer->owner = owner;
+        timer->next = NULL;
+    }
+    return timer;
+}
+
+/*
+ * @brief   Returns a disarmed timer to the free list
+ * @param   [in/out] Timer * timer: timer freed
+ */
+PRIVATE void timerFree(Timer * timer)
+{
+    timer->owner = NULL;
+    timer->next = freeTimers;
+    freeTimers = timer;
+}
+
+/*
+ * @brief   Inserts a timer into the armed list after every timer
+ *          expiring at or before it
+ * @param   [in/out] Timer * timer: timer with its expiry set
+ */
+PRIVATE void timerArm(Timer * timer)
+{
+    Timer ** link = &armed;
+
+    while(*link && !DEADLINE_BEFORE(timer->expiry, (*link)->expiry))
+    {
+        link = &((*link)->next);
+    }
+    timer->next = *link;
+    *link = timer;
+}
+
+/*
+ * @brief   Removes a timer from the armed list if it is there
+ * @param   [in/out] Timer * timer: timer disarmed
+ */
+PRIVATE void timerDisarm(Timer * timer)
+{
+    Timer ** link = &armed;
+
+    while(*link && *link != timer)
+    {
+        link = &((*link)->next);
+    }
+    if(*link)
+    {
+        *link = timer->next;
+    }
+}
+
+/*
+ * @brief   Called from pendSV on every SysTick: handles each timer
+ *          whose expiry has been reached. A periodic process waiting
+ *          on its period is made ready, as is one whose eventWait()
+ *          timed out; a software timer posts its TimerEvent and, if
+ *          periodic, is armed again.
+ * @param   [in] unsigned long now: current tick
+ */
+void timerExpire(unsigned long now)
+{
+    Timer * timer;
+    PCB * process;
+    TimerEvent event;
+
+    while(armed && !DEADLINE_BEFORE(now, armed->expiry))
+    {
+        timer = armed;
+        armed = timer->next;
+
+        if(timer->type == TIMER_RELEASE)
+        {
+            process = timer->owner;
+            process->waitingRelease = FALSE;
+            process->blockedCycles += CYCLE_COUNT() - process->blockedAt;
+            edfRelease(process, timer->expiry);
+            addPCB(process, process->priority);
+        }
+        else if(timer->type == TIMER_EVENT)
+        {
+            process = timer->owner;
+            process->eventTimer = NULL;
+            timerFree(timer);
+            eventTimeout(process);
+        }
+        /* A timer stops once its mailbox has been released */
+        else if(getOwnerPCB(timer->MB) != timer->owner)
+        {
+            timerFree(timer);
+        }
+        else
+        {
+            event.timer = timer - timers;
+            event.tick = timer->expiry;
+            kernelPost(timer->MB, TIMER_SOURCE, &event, sizeof(TimerEvent));
+            if(timer->period)
+            {
+                timer->expiry += timer->period;
+                timerArm(timer);
+            }
+            else
+            {
+                timerFree(timer);
+            }
+        }
+    }
+}
+
+/*
+ * @brief   Ends the current job of a periodic process. If its next
+ *          release is still to come the process leaves the CPU until
+ *          then; if it overran, the next job starts at once.
+ * @param   [in/out] PCB * process: the RUNNING process
+ * @return  int: 1 -> success; -1 -> the process has no period or
+ *               no timer is free
+ */
+int kernelWaitNextPeriod(PCB * process)
+{
+    unsigned long next;
+
+    if(!process->period)
+    {
+        return FAILURE;
+    }
+    if(!process->releaseTimer)
+    {
+        process->releaseTimer = timerAllocate(process);
+        if(!process->releaseTimer)
+        {
+            return FAILURE;
+        }
+        process->releaseTimer->type = TIMER_RELEASE;
+        process->releaseTimer->period = 0;
+    }
+
+    edfCheckDeadline(process);
+    next = process->release + process->period;
+    if(DEADLINE_BEFORE(sysTicks(), next))
+    {
+        removePCB();
+        process->waitingRelease = TRUE;
+        process->blockedAt = CYCLE_COUNT();
+        process->releaseTimer->expiry = next;
+        timerArm(process->releaseTimer);
+    }
+    else
+    {
+        edfRelease(process, next);
+    }
+    return SUCCESS;
+}
+
+/*
+ * @brief   Starts a software timer that posts to a mailbox
+ * @param   [in] PCB * owner: calling process, which must own MB
+ *          [in] int MB: mailbox posted to
+ *          [in] unsigned long ticks: ticks to the first expiry
+ *          [in] int periodic: TRUE to repeat every ticks
+ * @return  int: timer ID; -1 -> invalid arguments or no timer is free
+ */
+int kernelTimerStart(PCB * owner, int MB, unsigned long ticks, int periodic)
+{
+    Timer * timer;
+
+    if(!ticks || MB < 0 || MB >= MAILBOX_AMOUNT || getOwnerPCB(MB) != owner)
+    {
+        return FAILURE;
+    }
+
+    timer = timerAllocate(owner);
+    if(!timer)
+    {
+        return FAILURE;
+    }
+    timer->type = TIMER_MESSAGE;
+    timer->MB = MB;
+    timer->period = (periodic) ? ticks : 0;
+    timer->expiry = sysTicks() + ticks;
+    timerArm(timer);
+    return timer - timers;
+}
+
+/*
+ * @brief   Stops a software timer
+ * @param   [in] PCB * owner: calling process
+ *          [in] int id: timer ID from timerStart()
+ * @return  int: 1 -> success; -1 -> not a running timer of the caller
+ */
+int kernelTimerCancel(PCB * owner, int id)
+{
+    if(id < 0 || id >= TIMER_AMOUNT || timers[id].owner != owner ||
+       timers[id].type != TIMER_MESSAGE)
+    {
+        return FAILURE;
+    }
+
+    timerDisarm(&timers[id]);
+    timerFree(&timers[id]);
+    return SUCCESS;
+}
+
+/*
+ * @brief   Arms a one-shot timer ending a process' eventWait() after
+ *          a number of ticks
+ * @param   [in/out] PCB * process: process about to wait
+ *          [in] unsigned long ticks: ticks to the timeout
+ * @return  int: 1 -> success; -1 -> no timer is free
+ */
+int eventTimerStart(PCB * process, unsigned long ticks)
+{
+    Timer * timer = timerAllocate(process);
+
+    if(!timer)
+    {
+        return FAILURE;
+    }
+    timer->type = TIMER_EVENT;
+    timer->period = 0;
+    timer->expiry = sysTicks() + ticks;
+    timerArm(timer);
+    process->eventTimer = timer;
+    return SUCCESS;
+}
+
+/*
+ * @brief   Stops the timer of a process' eventWait(), if it has one
+ * @param   [in/out] PCB * process: process whose wait was satisfied
+ */
+void eventTimerCancel(PCB * process)
+{
+    if(process->eventTimer)
+    {
+        timerDisarm(process->eventTimer);
+        timerFree(process->eventTimer);
+        process->eventTimer = NULL;
+    }
+}
+
+/*
+ * @brief   Frees the release timer and software timers of a
+ *          terminating process
+ * @param   [in] PCB * owner: process terminating
+ */
+void freeProcessTimers(PCB * owner)
+{
+    int i;
+
+    for(i = 0; i < TIMER_AMOUNT; i++)
+    {
+        if(timers[i].owner == owner)
+        {
+            timerDisarm(&timers[i]);
+            timerFree(&timers[i]);
+        }
+    }
+    owner->releaseTimer = NULL;
+    owner->eventTimer = NULL;
+}
@@ -0,0 +1,64 @@
+/*
+ * @file    Timer.h
+ * @brief   Kernel timers driven by SysTick.
+ *          Periodic process releases (waitNextPeriod()) and software
+ *          timers (timerStart()) share one list of armed timers sorted
+ *          by expiry tick. Every SysTick, pendSV pops the timers that
+ *          have expired from its head, so the cost per tick is
+ *          proportional to the number expiring. Arming a timer is a
+ *          sorted insert.
+ *          A software timer posts a TimerEvent to its mailbox, from
+ *          TIMER_SOURCE, on each expiry. An event timer ends the
+ *          eventWait() of its process (Events.h).
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "Process.h"
+
+/* Timers available to processes and periodic releases together */
+#define TIMER_AMOUNT        16
+/* Mailbox a timer message is reported to come from */
+#define TIMER_SOURCE        -1
+
+enum timertypes {TIMER_RELEASE, TIMER_MESSAGE, TIMER_EVENT};
+
+/*
+ * @brief   Timer Structure
+ * @details An armed timer is linked into the expiry list, a free one
+ *          into the free list
+ */
+typedef struct Timer_
+{
+    unsigned long expiry;//tick of the next expiry
+    unsigned long period;//ticks between expiries, 0 for one-shot
+    int type;//enum timertypes
+    int MB;//TIMER_MESSAGE: mailbox posted to
+    PCB * owner;//process released or waiting, or that started the timer
+    struct Timer_ * next;
+}Timer;
+
+/*
+ * @brief   Timer Event Structure
+ * @details Message posted by a software timer
+ */
+typedef struct TimerEvent_
+{
+    int timer;//ID returned by timerStart()
+    unsigned long tick;//expiry tick
+}TimerEvent;
+
+#ifndef GLOBAL_TIMER
+#define GLOBAL_TIMER
+
+extern void initTimers(void);
+extern void timerExpire(unsigned long);
+extern int kernelWaitNextPeriod(PCB *);
+extern int kernelTimerStart(PCB *, int, unsigned long, int);
+extern int kernelTimerCancel(PCB *, int);
+extern int eventTimerStart(PCB *, unsigned long);
+extern void eventTimerCancel(PCB *);
+extern void freeProcessTimers(PCB *);
+
+#endif /* GLOBAL_TIMER */
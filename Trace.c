@@ -0,0 +1,135 @@
+/*
+ * @file    Trace.c
+ * @brief   Contains the kernel trace buffer and its UART dump
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define GLOBAL_TRACE
+#include "Trace.h"
+#include "UART.h"
+#include "Console.h"
+#include "Utilities.h"
+
+#define HEX_DIGITS_LONG  8
+#define HEX_DIGITS_BYTE  2
+#define HEX_DIGITS_SHORT 4
+#define BYTES_LONG       4
+#define BYTES_SHORT      2
+#define BYTE_BITS        8
+
+TraceLog traceLog = {TRACE_MAGIC, 0};
+
+/*
+ * @brief   Writes a value as fixed width hexadecimal followed by
+ *          a separator character
+ * @param   [in] unsigned long value: value to be written
+ *          [in] int digits: number of hex digits to write
+ *          [in] char separator: character written after the value
+ */
+static void traceHex(unsigned long value, int digits, char separator)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+
+    while(digits--)
+    {
+        forceOutput(hexDigits[(value >> (digits * 4)) & 0xF]);
+    }
+    forceOutput(separator);
+}
+
+/*
+ * @brief   Writes a NUL terminated string. printString() is not used
+ *          since it advances the cursor of the printing process.
+ * @param   [in] char * string: string to be written
+ */
+static void traceString(char * string)
+{
+    while(*string)
+    {
+        forceOutput(*(string++));
+    }
+}
+
+/*
+ * @brief   Adds a value to the open console record, little-endian
+ * @param   [in] unsigned long value: value to be added
+ *          [in] int bytes: number of bytes to add
+ */
+static void traceBytes(unsigned long value, int bytes)
+{
+    unsigned char data;
+
+    while(bytes--)
+    {
+        data = (unsigned char)(value & 0xFF);
+        consoleBytes(&data, 1);
+        value >>= BYTE_BITS;
+    }
+}
+
+/*
+ * @brief   Writes the trace buffer as one CONSOLE_TRACE record, each
+ *          event packed as timestamp (4 bytes), type, arg, pid (2 bytes)
+ * @param   [in] unsigned long head: events ever recorded
+ *          [in] unsigned long count: events written, oldest first
+ */
+static void traceRecord(unsigned long head, unsigned long count)
+{
+    unsigned long i;
+    TraceEvent * event;
+
+    consoleBegin(CONSOLE_TRACE);
+    traceBytes(head, BYTES_LONG);
+    traceBytes(count, BYTES_LONG);
+    for(i = head - count; i != head; i++)
+    {
+        event = &traceLog.events[i & TRACE_MASK];
+        traceBytes(event->timestamp, BYTES_LONG);
+        traceBytes(event->type, 1);
+        traceBytes(event->arg, 1);
+        traceBytes(event->pid, BYTES_SHORT);
+    }
+    consoleEnd();
+}
+
+/*
+ * @brief   Writes the contents of the trace buffer to UART0 as text,
+ *          oldest event first. Output format (all values hex):
+ *              TRACE <head> <count>
+ *              <timestamp> <type> <pid> <arg>
+ *              ...
+ *              END
+ *          Called from a process; the kernel keeps recording while
+ *          the dump is written so the oldest entries may be overwritten
+ *          if the system is busy. In binary console mode the buffer
+ *          is written as a CONSOLE_TRACE record instead.
+ */
+void traceDump(void)
+{
+    unsigned long head = traceLog.head;
+    unsigned long count = (head < TRACE_BUFFER_SIZE) ? head : TRACE_BUFFER_SIZE;
+    unsigned long i;
+    TraceEvent * event;
+
+    if(getConsoleMode() == CONSOLE_BINARY)
+    {
+        traceRecord(head, count);
+        return;
+    }
+
+    traceString("\r\nTRACE ");
+    traceHex(head, HEX_DIGITS_LONG, ' ');
+    traceHex(count, HEX_DIGITS_LONG, '\n');
+
+    for(i = head - count; i != head; i++)
+    {
+        event = &traceLog.events[i & TRACE_MASK];
+        traceHex(event->timestamp, HEX_DIGITS_LONG, ' ');
+        traceHex(event->type, HEX_DIGITS_BYTE, ' ');
+        traceHex(event->pid, HEX_DIGITS_SHORT, ' ');
+        traceHex(event->arg, HEX_DIGITS_BYTE, '\n');
+    }
+
+    traceString("END\n");
+}
@@ -0,0 +1,81 @@
+/*
+ * @file    Trace.h
+ * @brief   Kernel event trace buffer.
+ *          Events are written into a power-of-two ring buffer
+ *          with a DWT cycle timestamp and the pid of the process
+ *          concerned. Tracing is compiled in only when KERNEL_TRACE
+ *          is defined (e.g. --define=KERNEL_TRACE), otherwise TRACE()
+ *          expands to nothing.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+#include "DWT.h"
+
+/* Number of events kept; must be a power of two */
+#define TRACE_BUFFER_SIZE   256
+#define TRACE_MASK          (TRACE_BUFFER_SIZE - 1)
+/* Marks the start of a trace log in a memory image ("TRCE") */
+#define TRACE_MAGIC         0x54524345UL
+
+enum traceevents {TRACE_SWITCH, TRACE_SVC, TRACE_BLOCK, TRACE_WAKE,
+                  TRACE_BIND, TRACE_UNBIND};
+
+/*
+ * @brief   Trace Event Structure
+ * @details A single 8 byte trace record.
+ *          TRACE_SWITCH: pid is the process switched in, arg the
+ *                        low byte of the pid switched out
+ *          TRACE_SVC:    pid is the caller, arg the kernel call code
+ *          TRACE_BLOCK:  pid blocks receiving on mailbox arg
+ *          TRACE_WAKE:   pid is woken by a send to mailbox arg
+ *          TRACE_BIND/TRACE_UNBIND: pid (un)binds mailbox arg
+ */
+typedef struct TraceEvent_
+{
+    unsigned long timestamp;//DWT cycle count at time of event
+    unsigned char type;
+    unsigned char arg;
+    unsigned short pid;
+}TraceEvent;
+
+/*
+ * @brief   Trace Log Structure
+ * @details Ring buffer of events. head counts every event ever
+ *          recorded; the newest event is at (head - 1) & TRACE_MASK.
+ *          Saving this structure from memory gives a self describing
+ *          image for the host decoder.
+ */
+typedef struct TraceLog_
+{
+    unsigned long magic;
+    unsigned long head;
+    TraceEvent events[TRACE_BUFFER_SIZE];
+}TraceLog;
+
+#ifdef KERNEL_TRACE
+
+#define TRACE(TYPE, PID, ARG)                                               \
+    do                                                                      \
+    {                                                                       \
+        TraceEvent * traceEvent = &traceLog.events[traceLog.head++ & TRACE_MASK]; \
+        traceEvent->timestamp = CYCLE_COUNT();                              \
+        traceEvent->type = (TYPE);                                          \
+        traceEvent->arg = (unsigned char)(ARG);                             \
+        traceEvent->pid = (unsigned short)(PID);                            \
+    } while(0)
+
+#else
+
+#define TRACE(TYPE, PID, ARG)   do {} while(0)
+
+#endif /* KERNEL_TRACE */
+
+#ifndef GLOBAL_TRACE
+#define GLOBAL_TRACE
+
+extern TraceLog traceLog;
+extern void traceDump(void);
+
+#endif /* GLOBAL_TRACE */
@@ -10,12 +10,14 @@
  */
 
 #define GLOBAL_UART
+#include <string.h>
 #include "UART.h"
 #include "KernelCall.h"
 #include "Utilities.h"
 #include "SVC.h"
 #include "Process.h"
 #include "Messages.h"
+#include "Console.h"
 
 
 #define TRUE    1
@@ -25,17 +27,104 @@ static char dataRegister;
 static int gotData = FALSE;
 static PCB * printingProcess;
 
+/*
+ * @brief   Adds a message to the batch being merged, as its size, its
+ *          bytes and a NUL so printString() stops at its end
+ * @param   [in/out] char * batch: fragments of one sender
+ *          [in/out] int * batchSize: bytes of batch used
+ *          [in] char * contents: message received
+ *          [in] int size: bytes received
+ */
+static void batchAdd(char * batch, int * batchSize, char * contents, int size)
+{
+    batch[(*batchSize)++] = (char)size;
+    memcpy(&batch[*batchSize], contents, size);
+    *batchSize += size;
+    batch[(*batchSize)++] = NUL;
+}
+
+/*
+ * @brief   Writes the merged fragments of one sender: as text, or in
+ *          binary mode as one CONSOLE_MESSAGE record holding each
+ *          fragment unchanged, advancing the sender's cursor as
+ *          printString() does
+ * @param   [in] int fromMB: mailbox the fragments were sent from
+ *          [in] char * batch: fragments added by batchAdd()
+ *          [in] int batchSize: bytes of batch used
+ */
+static void batchWrite(int fromMB, char * batch, int batchSize)
+{
+    unsigned char sender[2];
+    int offset = 0;
+    int size;
+
+    printingProcess = getOwnerPCB(fromMB);
+    if(getConsoleMode() == CONSOLE_BINARY)
+    {
+        sender[0] = (unsigned char)(fromMB & 0xFF);
+        sender[1] = (unsigned char)((fromMB >> 8) & 0xFF);
+        consoleBegin(CONSOLE_MESSAGE);
+        consoleBytes(sender, sizeof(sender));
+        while(offset < batchSize)
+        {
+            size = (unsigned char)batch[offset];
+            consoleNumber(size);
+            consoleBytes(&batch[offset + 1], size);
+            if(printingProcess && batch[offset + 1] != ESC)
+            {
+                printingProcess->xAxisCursorPosition += strlen(&batch[offset + 1]);
+            }
+            offset += size + 2;
+        }
+        consoleEnd();
+        return;
+    }
+
+    while(offset < batchSize)
+    {
+        printString(&batch[offset + 1]);
+        offset += (unsigned char)batch[offset] + 2;
+    }
+}
+
+/*
+ * @brief   The console server. Messages to UART_MB are written in the
+ *          order received, but whatever else is queued is taken with
+ *          pollMessage() before writing, the consecutive fragments of one sender merged into
+ *          one write, so their pool messages are free while the UART is
+ *          busy. At UART_QUEUE_LIMIT queued, senders block until the
+ *          console catches up rather than emptying the pool.
+ */
 void uartProcess(void)
 {
     bind(UART_MB);
+    registerName("uart", UART_MB);
+    mailboxControl(UART_MB, MB_OPT_LIMIT, UART_QUEUE_LIMIT);
     int toMB;
+    int batchMB;
     char cont[MESSAGE_SYS_LIMIT];
+    char batch[UART_BATCH];
+    int batchSize;
     int size = MESSAGE_SYS_LIMIT;
+    int received;
     while(1)
     {
-        recvMessage(ANY, &toMB, cont, size);
-        printingProcess = getOwnerPCB(toMB);
-        printString(cont);
+        received = recvMessage(ANY, &toMB, cont, size);
+        batchMB = toMB;
+        batchSize = 0;
+        batchAdd(batch, &batchSize, cont, received);
+
+        while((received = pollMessage(UART_MB, &toMB, cont, size)) >= 0)
+        {
+            if(toMB != batchMB || batchSize + received + 2 > UART_BATCH)
+            {
+                batchWrite(batchMB, batch, batchSize);
+                batchMB = toMB;
+                batchSize = 0;
+            }
+            batchAdd(batch, &batchSize, cont, received);
+        }
+        batchWrite(batchMB, batch, batchSize);
     }
 }
 
@@ -113,12 +202,18 @@ void UART0_IntEnable(unsigned long flags)
 /*
  * @brief   Force character into the data register
  * @param   [in] char data: character to be put into
- *          data register
+ *          data register; in binary mode, added to a text record
  */
 void forceOutput(char data)
 {
-        while(UART0_FR_R & UART_FR_TXFF);//wait until not busy
-        UART0_DR_R = data;
+    if(getConsoleMode() == CONSOLE_BINARY)
+    {
+        consoleText(data);
+    }
+    else
+    {
+        UART_PUTCHAR(data);
+    }
 }
 
 /*
@@ -130,19 +225,23 @@ void forceOutput(char data)
  */
 void printString(char* string)
 {
-    int increaseCursor = (*string == ESC)? FALSE : TRUE;
+    //the sender may have unbound since its message was queued
+    int increaseCursor = (*string == ESC || !printingProcess)? FALSE : TRUE;
 
     while(*string)
     {
         forceOutput(*(string++));
-        printingProcess->xAxisCursorPosition+=increaseCursor;
+        if(increaseCursor)
+        {
+            printingProcess->xAxisCursorPosition++;
+        }
     }
 }
 
 
 void printWarning(int returnValue)
 {
-    if(returnValue<NULL)
+    if(returnValue<0)
     {
         switch(returnValue)
         {
@@ -9,21 +9,22 @@
  * @date    26-Oct-2019 (modified)
  */
 #pragma once
-
-#define GPIO_PORTA_AFSEL_R  (*((volatile unsigned long *)0x40058420))   // GPIOA Alternate Function Select Register
-#define GPIO_PORTA_DEN_R    (*((volatile unsigned long *)0x4005851C))   // GPIOA Digital Enable Register
-#define GPIO_PORTA_PCTL_R   (*((volatile unsigned long *)0x4005852C))   // GPIOA Port Control Register
-#define UART0_DR_R          (*((volatile unsigned long *)0x4000C000))   // UART0 Data Register
-#define UART0_FR_R          (*((volatile unsigned long *)0x4000C018))   // UART0 Flag Register
-#define UART0_IBRD_R        (*((volatile unsigned long *)0x4000C024))   // UART0 Integer Baud-Rate Divisor Register
-#define UART0_FBRD_R        (*((volatile unsigned long *)0x4000C028))   // UART0 Fractional Baud-Rate Divisor Register
-#define UART0_LCRH_R        (*((volatile unsigned long *)0x4000C02C))   // UART0 Line Control Register
-#define UART0_CTL_R         (*((volatile unsigned long *)0x4000C030))   // UART0 Control Register
-#define UART0_IFLS_R        (*((volatile unsigned long *)0x4000C034))   // UART0 Interrupt FIFO Level Select Register
-#define UART0_IM_R          (*((volatile unsigned long *)0x4000C038))   // UART0 Interrupt Mask Register
-#define UART0_MIS_R         (*((volatile unsigned long *)0x4000C040))   // UART0 Masked Interrupt Status Register
-#define UART0_ICR_R         (*((volatile unsigned long *)0x4000C044))   // UART0 Interrupt Clear Register
-#define UART0_CC_R          (*((volatile unsigned long *)0x4000CFC8))   // UART0 Clock Control Register
+#include "Hardware.h"
+
+#define GPIO_PORTA_AFSEL_R  HW_REGISTER(0x40058420)   // GPIOA Alternate Function Select Register
+#define GPIO_PORTA_DEN_R    HW_REGISTER(0x4005851C)   // GPIOA Digital Enable Register
+#define GPIO_PORTA_PCTL_R   HW_REGISTER(0x4005852C)   // GPIOA Port Control Register
+#define UART0_DR_R          HW_REGISTER(0x4000C000)   // UART0 Data Register
+#define UART0_FR_R          HW_REGISTER(0x4000C018)   // UART0 Flag Register
+#define UART0_IBRD_R        HW_REGISTER(0x4000C024)   // UART0 Integer Baud-Rate Divisor Register
+#define UART0_FBRD_R        HW_REGISTER(0x4000C028)   // UART0 Fractional Baud-Rate Divisor Register
+#define UART0_LCRH_R        HW_REGISTER(0x4000C02C)   // UART0 Line Control Register
+#define UART0_CTL_R         HW_REGISTER(0x4000C030)   // UART0 Control Register
+#define UART0_IFLS_R        HW_REGISTER(0x4000C034)   // UART0 Interrupt FIFO Level Select Register
+#define UART0_IM_R          HW_REGISTER(0x4000C038)   // UART0 Interrupt Mask Register
+#define UART0_MIS_R         HW_REGISTER(0x4000C040)   // UART0 Masked Interrupt Status Register
+#define UART0_ICR_R         HW_REGISTER(0x4000C044)   // UART0 Interrupt Clear Register
+#define UART0_CC_R          HW_REGISTER(0x4000CFC8)   // UART0 Clock Control Register
 
 #define INT_VEC_UART0           5           // UART0 Rx and Tx interrupt index (decimal)
 #define UART_FR_TXFF            0x00000020  // UART Transmit FIFO Full
@@ -42,25 +43,35 @@
 #define EN_DIG_PA0              0x00000001  // Enable Digital I/O on PA0
 #define EN_DIG_PA1              0x00000002  // Enable Digital I/O on PA1
 
+/* Writes a character once the transmit FIFO has room; Hardware.h may substitute its own */
+#ifndef UART_PUTCHAR
+#define UART_PUTCHAR(data)      do { while(UART0_FR_R & UART_FR_TXFF); UART0_DR_R = (data); } while(0)
+#endif
+
 // Clock Gating Registers
-#define SYSCTL_RCGCGPIO_R      (*((volatile unsigned long *)0x400FE608))
-#define SYSCTL_RCGCUART_R      (*((volatile unsigned long *)0x400FE618))
+#define SYSCTL_RCGCGPIO_R      HW_REGISTER(0x400FE608)
+#define SYSCTL_RCGCUART_R      HW_REGISTER(0x400FE618)
 
 #define SYSCTL_RCGCGPIO_UART0      0x00000001  // UART0 Clock Gating Control
 #define SYSCTL_RCGCUART_GPIOA      0x00000001  // Port A Clock Gating Control
 
 // Clock Configuration Register
-#define SYSCTRL_RCC_R           (*((volatile unsigned long *)0x400FE0B0))
+#define SYSCTRL_RCC_R           HW_REGISTER(0x400FE0B0)
 
 #define CLEAR_USRSYSDIV     0xF83FFFFF  // Clear USRSYSDIV Bits
 #define SET_BYPASS      0x00000800  // Set BYPASS Bit
 
-#define NVIC_EN0_R      (*((volatile unsigned long *)0xE000E100))   // Interrupt 0-31 Set Enable Register
-#define NVIC_EN1_R      (*((volatile unsigned long *)0xE000E104))   // Interrupt 32-54 Set Enable Register
+#define NVIC_EN0_R      HW_REGISTER(0xE000E100)   // Interrupt 0-31 Set Enable Register
+#define NVIC_EN1_R      HW_REGISTER(0xE000E104)   // Interrupt 32-54 Set Enable Register
 
 
 #define NUL 0x00
 
+/* Messages queued to the UART process before senders block */
+#define UART_QUEUE_LIMIT    16
+/* Bytes of one sender's fragments merged into one write */
+#define UART_BATCH          256
+
 
 /* Cursor position string */
 
@@ -7,10 +7,12 @@
 #define GLOBAL_UTILITIES
 #define TWO_DIGITS 10
 #include <stdlib.h>
+#include <string.h>
 #include "Utilities.h"
 #include "Messages.h"
 #include "SVC.h"
 #include "UART.h"
+#include "KernelCall.h"
 
 
 void formatLineNumber(int val, char* rtn)
@@ -25,10 +27,60 @@ void formatLineNumber(int val, char* rtn)
     }
 }
 
+/*
+ * @brief   Adds one sample to a latency histogram
+ * @param   [in/out] LatencyHistogram * histogram: histogram updated
+ *          [in] unsigned long cycles: the sample
+ */
+void latencyRecord(LatencyHistogram * histogram, unsigned long cycles)
+{
+    unsigned long scaled = cycles;
+    int bucket = 0;
+
+    /* Bucket is floor(log2(cycles)) */
+    while((scaled >>= 1) && (bucket < LATENCY_BUCKETS - 1))
+    {
+        bucket++;
+    }
+
+    histogram->buckets[bucket]++;
+    histogram->min = (!histogram->count || cycles < histogram->min) ? cycles : histogram->min;
+    histogram->count++;
+    histogram->max = (cycles > histogram->max) ? cycles : histogram->max;
+    histogram->total += cycles;
+}
+
+/*
+ * @brief   Estimates a percentile of a latency histogram
+ * @param   [in] LatencyHistogram * histogram: histogram from getLatency()
+ *          [in] int percent: percentile wanted, 0 to 100
+ * @return  unsigned long: upper bound in cycles of the bucket holding the
+ *          percentile, capped at the recorded maximum; 0 if empty
+ */
+unsigned long latencyPercentile(LatencyHistogram * histogram, int percent)
+{
+    /* Rank of the sample at the percentile, rounded up */
+    unsigned long rank = (histogram->count * percent + 99) / 100;
+    unsigned long seen = 0;
+    unsigned long bound;
+    int bucket;
+
+    for(bucket = 0; bucket < LATENCY_BUCKETS; bucket++)
+    {
+        seen += histogram->buckets[bucket];
+        if(seen && seen >= rank)
+        {
+            bound = (2UL << bucket) - 1;
+            return (bound < histogram->max) ? bound : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
 void getProcessCursor(int lineNumber, char *cursorString)
 {
-    char printLine[POSITION_DIGITS];
-    char cursorPosition[POSITION_DIGITS];
+    char printLine[POSITION_DIGITS + 1];
+    char cursorPosition[POSITION_DIGITS + 1];
     PCB* runningPCB = getRunningPCB();
 
     formatLineNumber(lineNumber, printLine);
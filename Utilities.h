@@ -10,8 +10,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#define     disable()   __asm(" cpsid i") //disable interrupts
-#define     enable()    __asm(" cpsie i")//enable interrupts
+#include    "Hardware.h"    // disable()/enable()
 #define     ENTER       0x0d //ASCII Characters
 #define     BS          0x08
 #define     NUL         0x00
@@ -24,14 +23,18 @@
 #define     FALSE       0
 #define     SUCCESS     1   // To clarify returns values where possible
 #define     FAILURE     -1
+#ifndef     NULL
 #define     NULL        0
+#endif
 #define     EMPTY       0       //Queue return values
 #define     FULL        0
-#define     ANY         16      //signals bind any
+#define     ANY         -1      //signals bind/receive any
 #define     SEND_FAIL   -2
 #define     RECV_FAIL   -3
 #define     BIND_FAIL   -4
 #define     UNBIND_FAIL -5
+#define     JOIN_FAIL   -6
+#define     RECV_EMPTY  -7      //nothing queued for a poll
 #define     DEFAULT_FAIL FAILURE
 #define     MESSAGE_SYS_LIMIT 32
 #define     RECEIVE_LOG_AMOUNT MESSAGE_SYS_LIMIT
@@ -39,11 +42,15 @@
 #define     CURSOR_STRING   9
 
 
+struct LatencyHistogram_;
+
 #ifndef     GLOBAL_UTILITIES
 #define     GLOBAL_UTILITIES
 
 extern void formatLineNumber(int,char*);
 extern void getProcessCursor(int,char*);
+extern unsigned long latencyPercentile(struct LatencyHistogram_ *, int);
+extern void latencyRecord(struct LatencyHistogram_ *, unsigned long);
 
 #else
 
@@ -0,0 +1,192 @@
+/*
+ * @file    HostHardware.c
+ * @brief   Simulated register file, cycle counter, console and
+ *          bridge link for the hosted kernel build
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "HostPort.h"
+
+#define HOST_REGISTERS      128
+#define HOST_REGISTER_MASK  (HOST_REGISTERS - 1)
+#define NANOSECONDS         1000000000ULL
+
+/* One simulated memory mapped register */
+typedef struct HostRegister_
+{
+    unsigned long address;
+    volatile unsigned long value;
+    int used;
+}HostRegister;
+
+static HostRegister registerFile[HOST_REGISTERS];
+/* Descriptors of the bridge link, -1 if it has none */
+static int linkRx = -1;
+static int linkTx = -1;
+
+/*
+ * @brief   Returns the storage simulating a memory mapped register.
+ *          Registers read back what was last written; all start at 0.
+ * @param   [in] unsigned long address: target address of the register
+ * @return  volatile unsigned long *: its simulated storage
+ */
+volatile unsigned long * hostRegister(unsigned long address)
+{
+    unsigned long slot = (address >> 2) & HOST_REGISTER_MASK;
+    int probes;
+
+    for(probes = 0; probes < HOST_REGISTERS; probes++)
+    {
+        if(!registerFile[slot].used)
+        {
+            registerFile[slot].used = 1;
+            registerFile[slot].address = address;
+        }
+        if(registerFile[slot].address == address)
+        {
+            return &registerFile[slot].value;
+        }
+        slot = (slot + 1) & HOST_REGISTER_MASK;
+    }
+
+    fprintf(stderr, "host: register file full at 0x%08lx\n", address);
+    exit(EXIT_FAILURE);
+}
+
+/*
+ * @brief   Simulated DWT CYCCNT: monotonic time since the first call
+ *          scaled to HOST_CPU_HZ. Unlike the target it does not wrap.
+ * @return  unsigned long: elapsed cycles
+ */
+unsigned long hostCycleCount(void)
+{
+    static unsigned long long start = 0;
+    struct timespec now;
+    unsigned long long nanoseconds;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    nanoseconds = now.tv_sec * NANOSECONDS + now.tv_nsec;
+    if(!start)
+    {
+        start = nanoseconds;
+    }
+    return (unsigned long)(((nanoseconds - start) * HOST_CPU_HZ) / NANOSECONDS);
+}
+
+/*
+ * @brief   UART0 data register write. write() is used rather than stdio
+ *          since a process can be preempted part way through a call.
+ * @param   [in] char data: character to output
+ */
+void hostPutChar(char data)
+{
+    ssize_t written = write(STDOUT_FILENO, &data, 1);
+    (void)written;
+}
+
+/*
+ * @brief   Start of the executable's text, the host PROFILE_BASE
+ * @return  unsigned long: load address of the executable
+ */
+unsigned long hostTextBase(void)
+{
+    extern char __executable_start;
+
+    return (unsigned long)&__executable_start;
+}
+
+/*
+ * @brief   Ends the hosted run
+ * @param   [in] int code: process exit status
+ */
+void hostExit(int code)
+{
+    fflush(stdout);
+    _exit(code);
+}
+
+/*
+ * @brief   Opens the bridge link: the file or descriptor in HOST_LINK,
+ *          otherwise a pipe to itself if loopback is asked for; with
+ *          neither, bytes written are discarded
+ * @param   [in] int loopback: TRUE for a pipe to itself
+ */
+void hostLinkOpen(int loopback)
+{
+    char * link = getenv(HOST_LINK_ENV);
+    char * end;
+    struct termios raw;
+    int ends[2];
+
+    if(link)
+    {
+        linkRx = (int)strtol(link, &end, 10);
+        if(!*link || *end)
+        {
+            linkRx = open(link, O_RDWR | O_NOCTTY);
+        }
+        if(linkRx < 0)
+        {
+            fprintf(stderr, "host: cannot open link %s\n", link);
+            exit(EXIT_FAILURE);
+        }
+        if(isatty(linkRx) && !tcgetattr(linkRx, &raw))
+        {
+            cfmakeraw(&raw);
+            tcsetattr(linkRx, TCSANOW, &raw);
+        }
+        linkTx = linkRx;
+    }
+    else if(loopback && !pipe(ends))
+    {
+        linkRx = ends[0];
+        linkTx = ends[1];
+    }
+
+    if(linkRx >= 0)
+    {
+        hostLinkInterrupts(linkRx);
+    }
+}
+
+/*
+ * @brief   UART1 data register write
+ * @param   [in] char data: byte to send on the link
+ */
+void hostLinkPut(char data)
+{
+    ssize_t written;
+
+    if(linkTx >= 0)
+    {
+        written = write(linkTx, &data, 1);
+        (void)written;
+    }
+}
+
+/*
+ * @brief   UART1 data register read, checking for a byte first as the
+ *          receive FIFO empty flag would
+ * @return  int: byte received; -1 if none is waiting
+ */
+int hostLinkGet(void)
+{
+    unsigned char data;
+    int waiting = 0;
+
+    if(linkRx < 0 || ioctl(linkRx, FIONREAD, &waiting) || waiting <= 0 ||
+       read(linkRx, &data, 1) != 1)
+    {
+        return -1;
+    }
+    return data;
+}
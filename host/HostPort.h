@@ -0,0 +1,75 @@
+/*
+ * @file    HostPort.h
+ * @brief   Hosted (POSIX) replacements for the Cortex-M pieces of
+ *          the kernel. Included by Hardware.h when the kernel is
+ *          compiled with HOST_PORT.
+ *
+ *          - Processes run as ucontext fibres on a single thread
+ *          - SVC traps call hostSVC(), which passes a simulated
+ *            stack frame to the unmodified SVCHandler
+ *          - Hardware registers are simulated in a small register
+ *            file; SysTick is driven by a POSIX interval timer and
+ *            a pended PendSV is taken on the way out of the tick
+ *          - UART0 output goes to stdout
+ *          - The bridge's UART1 link is the file or descriptor named
+ *            by HOST_LINK, or a pipe to itself for loopback; SIGIO
+ *            stands in for its receive interrupt
+ *          - LDREX/STREX compare-and-swap is the compiler's atomic
+ *            builtin, which a tick signal cannot split
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#pragma once
+
+/* Simulated core clock, matches the 16 MHz PIOSC the target runs from */
+#define HOST_CPU_HZ     16000000UL
+
+/* Environment variable giving the number of ticks to run before exiting */
+#define HOST_TICKS_ENV  "HOST_TICKS"
+#define HOST_DEFAULT_TICKS  100
+/* Environment variable naming the bridge link: a path, e.g. a pty, or
+ * the number of an open descriptor, e.g. one end of a socket pair */
+#define HOST_LINK_ENV   "HOST_LINK"
+
+/* Hardware.h substitutions */
+#define HW_REGISTER(address)    (*hostRegister(address))
+#define SVC()                   hostSVC()
+#define disable()               hostDisable()
+#define enable()                hostEnable()
+#define SET_BASEPRI(value)      hostSetBasePri(value)
+#define ASSIGN_R7(data)         hostAssignR7(data)
+/* hostSVC() performs the exception return itself */
+#define RETURN_TO_PSP()         do {} while(0)
+#define DMB()                   __sync_synchronize()
+#define COMPARE_AND_SWAP(address, expected, value) \
+    __sync_bool_compare_and_swap((address), (expected), (value))
+/* DWT.h and UART.h substitutions */
+#define CYCLE_COUNT()           hostCycleCount()
+#define UART_PUTCHAR(data)      hostPutChar(data)
+/* Profile.h substitutions: PCs are profiled relative to the executable */
+#define INTERRUPTED_PC()        hostInterruptedPC()
+#define PROFILE_BASE            hostTextBase()
+/* Interrupts.h substitution: cycles since the probe's signal arrived */
+#define PROBE_ELAPSED(timer)    hostProbeElapsed(timer)
+/* Bridge.h substitutions: the link is a host file */
+#define LINK_PUTCHAR(data)      hostLinkPut(data)
+#define LINK_GETCHAR()          hostLinkGet()
+#define LINK_OPEN(loopback)     hostLinkOpen(loopback)
+
+extern void hostSVC(void);
+extern void hostDisable(void);
+extern void hostEnable(void);
+extern void hostSetBasePri(unsigned long);
+extern void hostAssignR7(unsigned long);
+extern volatile unsigned long * hostRegister(unsigned long);
+extern unsigned long hostCycleCount(void);
+extern void hostPutChar(char);
+extern void hostExit(int);
+extern unsigned long hostInterruptedPC(void);
+extern unsigned long hostTextBase(void);
+extern unsigned long hostProbeElapsed(int);
+extern void hostLinkOpen(int);
+extern void hostLinkPut(char);
+extern int hostLinkGet(void);
+extern void hostLinkInterrupts(int);
@@ -0,0 +1,528 @@
+/*
+ * @file    HostProcess.c
+ * @brief   Hosted replacement for Process.c and the exception entry
+ *          and exit paths. Each kernel process runs as a ucontext
+ *          fibre. The PSP/MSP helpers keep the values the kernel hands
+ *          them; which fibre runs is decided from RUNNING whenever a
+ *          simulated exception (SVC or SysTick) returns.
+ * @author  Liam JA MacDonald
+ * @author  Patrick Wells
+ * @date    19-Oct-2026 (created)
+ */
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#include "../Process.h"
+#include "../SVC.h"
+#include "../KernelCall.h"
+#include "../SYSTICK.h"
+#include "../Profile.h"
+#include "../Interrupts.h"
+#include "../Bridge.h"
+#include "HostPort.h"
+
+#define HOST_MAX_CONTEXTS   64
+#define HOST_STACK_SIZE     (256 * 1024)
+#define ICSR_PENDSVSET      0x10000000UL
+#define MICROSECONDS        1000000UL
+
+extern void SVCHandler(StackFrame *);
+extern void pendSV(void);
+
+/* A process fibre, identified by the PCB it runs */
+typedef struct HostContext_
+{
+    PCB * pcb;
+    ucontext_t context;
+    char * stack;
+    /* TRUE until created, and again once the process terminates */
+    int dead;
+}HostContext;
+
+static HostContext contexts[HOST_MAX_CONTEXTS];
+/* Context of main(); abandoned once the first process starts */
+static ucontext_t mainContext;
+/* Fibre currently executing, NULL while still in main() */
+static HostContext * current = NULL;
+
+/* Simulated core registers */
+static unsigned long hostPSP;
+static unsigned long hostMSP;
+static unsigned long hostR7;
+
+/* Simulated exception state */
+static volatile sig_atomic_t inKernel = FALSE;
+static volatile sig_atomic_t masked = FALSE;
+static volatile sig_atomic_t tickPending = FALSE;
+/* TRUE while the pending tick interrupted process code at interruptedPC */
+static volatile sig_atomic_t tickFromProcess = FALSE;
+static unsigned long interruptedPC;
+static unsigned long ticks = 0;
+static unsigned long tickLimit = HOST_DEFAULT_TICKS;
+/* Latency probes: the kernel-aware one is masked like SysTick, the
+ * zero-latency one never is; each remembers when its signal arrived */
+static volatile sig_atomic_t probePending = FALSE;
+static volatile unsigned long probeArrival[IRQ_CLASSES];
+/* Bridge link data arrived (SIGIO), masked like SysTick */
+static volatile sig_atomic_t linkPending = FALSE;
+
+unsigned long get_PSP(void)
+{
+    return hostPSP;
+}
+
+unsigned long get_MSP(void)
+{
+    return hostMSP;
+}
+
+void set_PSP(volatile unsigned long ProcessStack)
+{
+    hostPSP = ProcessStack;
+}
+
+void set_MSP(volatile unsigned long MainStack)
+{
+    hostMSP = MainStack;
+}
+
+void volatile save_registers()
+{
+/* Registers live in the fibre's ucontext */
+}
+
+void volatile restore_registers()
+{
+/* Registers live in the fibre's ucontext */
+}
+
+unsigned long get_SP()
+{
+    volatile unsigned long marker;
+    return (unsigned long)&marker;
+}
+
+/*
+ * @brief   PC stacked by the process SysTick interrupted
+ * @return  unsigned long: its address
+ */
+unsigned long hostInterruptedPC(void)
+{
+    return interruptedPC;
+}
+
+/*
+ * @brief   Stands in for "mov r7,r0": remembers the kernel argument
+ *          structure of the next SVC
+ * @param   [in] unsigned long data: address of the KernelArgs
+ */
+void hostAssignR7(unsigned long data)
+{
+    hostR7 = data;
+}
+
+/*
+ * @brief   Finds the fibre of a PCB, claiming a free slot if it has none
+ * @param   [in] PCB * pcb: process of interest
+ * @return  HostContext *: its fibre
+ */
+static HostContext * contextOf(PCB * pcb)
+{
+    HostContext * freeSlot = NULL;
+    int i;
+
+    for(i = 0; i < HOST_MAX_CONTEXTS; i++)
+    {
+        if(contexts[i].pcb == pcb)
+        {
+            return &contexts[i];
+        }
+        if(!freeSlot && !contexts[i].pcb)
+        {
+            freeSlot = &contexts[i];
+        }
+    }
+
+    if(!freeSlot)
+    {
+        fprintf(stderr, "host: more than %d processes\n", HOST_MAX_CONTEXTS);
+        exit(EXIT_FAILURE);
+    }
+
+    freeSlot->pcb = pcb;
+    freeSlot->dead = TRUE;
+    return freeSlot;
+}
+
+/*
+ * @brief   First code run by a new fibre. Starts the process at the pc
+ *          registerProcess() placed in its initial stack frame, with r0
+ *          as its argument, and "returns" through the stacked lr
+ */
+static void processEntry(void)
+{
+    StackFrame * frame = (StackFrame *)current->pcb->sp;
+    void (*code)(unsigned long) = (void (*)(unsigned long))frame->pc;
+    void (*lr)(void) = (void (*)(void))frame->lr;
+
+    inKernel = FALSE;
+    code(frame->r0);
+    lr();
+}
+
+/*
+ * @brief   (Re)creates the fibre of a process that has never run
+ * @param   [in/out] HostContext * fibre: fibre to initialize
+ */
+static void createContext(HostContext * fibre)
+{
+    if(!fibre->stack)
+    {
+        fibre->stack = malloc(HOST_STACK_SIZE);
+    }
+    getcontext(&fibre->context);
+    fibre->context.uc_stack.ss_sp = fibre->stack;
+    fibre->context.uc_stack.ss_size = HOST_STACK_SIZE;
+    fibre->context.uc_link = NULL;
+    sigemptyset(&fibre->context.uc_sigmask);
+    makecontext(&fibre->context, processEntry, 0);
+    fibre->dead = FALSE;
+}
+
+/*
+ * @brief   Resumes the fibre of the given process, saving the current one
+ * @param   [in] PCB * to: process to run
+ */
+static void switchTo(PCB * to)
+{
+    HostContext * from = current;
+    HostContext * next = contextOf(to);
+
+    if(next == from)
+    {
+        return;
+    }
+
+    if(next->dead)
+    {
+        createContext(next);
+    }
+    current = next;
+
+    if(!from)
+    {
+        swapcontext(&mainContext, &next->context);
+    }
+    else if(from->dead)
+    {
+        setcontext(&next->context);
+    }
+    else
+    {
+        swapcontext(&from->context, &next->context);
+    }
+}
+
+/*
+ * @brief   Simulated exception return: takes a pending probe or link
+ *          interrupt, then a pending SysTick, then a pending PendSV,
+ *          then resumes whichever process is RUNNING.
+ *          Called with inKernel set.
+ */
+static void exceptionReturn(void)
+{
+    if(probePending && !masked)
+    {
+        probePending = FALSE;
+        ProbeKernelHandler();
+    }
+
+    if(linkPending && !masked)
+    {
+        linkPending = FALSE;
+        UART1_IntHandler();
+    }
+
+    if(tickPending && !masked)
+    {
+        tickPending = FALSE;
+        ticks++;
+        if(tickLimit && ticks >= tickLimit)
+        {
+            hostExit(EXIT_SUCCESS);
+        }
+        if((ST_CTRL_R & (ST_CTRL_ENABLE | ST_CTRL_INTEN)) == (ST_CTRL_ENABLE | ST_CTRL_INTEN))
+        {
+            /* As on the target, RETTOBASE tells the handler a process was interrupted */
+            if(tickFromProcess)
+            {
+                ICSR_R |= ICSR_RETTOBASE;
+            }
+            SYSTICKHandler();
+            ICSR_R &= ~ICSR_RETTOBASE;
+        }
+        tickFromProcess = FALSE;
+    }
+
+    if(ICSR_R & ICSR_PENDSVSET)
+    {
+        ICSR_R &= ~ICSR_PENDSVSET;
+        pendSV();
+    }
+
+    switchTo(getRunningPCB());
+}
+
+/*
+ * @brief   Takes a pending kernel-aware probe or link interrupt once the
+ *          kernel is idle and unmasked, as the NVIC would on leaving the
+ *          kernel. Before the first process starts they wait for the
+ *          first tick.
+ */
+static void takeProbe(void)
+{
+    if((probePending || linkPending) && current && !inKernel && !masked)
+    {
+        inKernel = TRUE;
+        exceptionReturn();
+        inKernel = FALSE;
+    }
+}
+
+/*
+ * @brief   Returns the PC a signal interrupted
+ * @param   [in] void * context: ucontext_t passed to the signal handler
+ * @return  unsigned long: interrupted PC, 0 if unknown on this host
+ */
+static unsigned long signalPC(void * context)
+{
+    ucontext_t * interrupted = (ucontext_t *)context;
+
+#if defined(__x86_64__)
+    return (unsigned long)interrupted->uc_mcontext.gregs[REG_RIP];
+#elif defined(__aarch64__)
+    return (unsigned long)interrupted->uc_mcontext.pc;
+#else
+    (void)interrupted;
+    return 0;
+#endif
+}
+
+/*
+ * @brief   SIGALRM handler standing in for the SysTick interrupt. If the
+ *          kernel is busy the tick is left pending and taken when it exits.
+ */
+static void tickHandler(int signalNumber, siginfo_t * information, void * context)
+{
+    tickPending = TRUE;
+    if(inKernel || masked)
+    {
+        return;
+    }
+
+    inKernel = TRUE;
+    interruptedPC = signalPC(context);
+    tickFromProcess = TRUE;
+    exceptionReturn();
+    inKernel = FALSE;
+    takeProbe();
+}
+
+/*
+ * @brief   SIGVTALRM handler standing in for the kernel-aware probe
+ *          timer: taken at once unless the kernel is busy or has masked
+ *          it, in which case it is taken when the kernel exits
+ */
+static void probeKernelSignal(int signalNumber)
+{
+    probeArrival[IRQ_KERNEL_AWARE] = hostCycleCount();
+    probePending = TRUE;
+    takeProbe();
+}
+
+/*
+ * @brief   SIGIO handler standing in for the UART1 receive interrupt;
+ *          masked and deferred like the kernel-aware probe
+ */
+static void linkSignal(int signalNumber)
+{
+    linkPending = TRUE;
+    takeProbe();
+}
+
+/*
+ * @brief   Raises the simulated UART1 interrupt whenever data arrives on
+ *          the link, and once at the first tick for data already there
+ * @param   [in] int descriptor: receiving end of the link
+ */
+void hostLinkInterrupts(int descriptor)
+{
+    struct sigaction action;
+
+    action.sa_handler = linkSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGIO, &action, NULL);
+
+    fcntl(descriptor, F_SETOWN, getpid());
+    fcntl(descriptor, F_SETFL, fcntl(descriptor, F_GETFL) | O_ASYNC);
+    linkPending = TRUE;
+}
+
+/*
+ * @brief   SIGPROF handler standing in for the zero-latency probe
+ *          timer; the kernel never masks it
+ */
+static void probeZeroSignal(int signalNumber)
+{
+    probeArrival[IRQ_ZERO_LATENCY] = hostCycleCount();
+    ProbeZeroHandler();
+}
+
+/*
+ * @brief   Cycles since a probe's signal arrived
+ * @param   [in] int timer: PROBE_KERNEL_TIMER or PROBE_ZERO_TIMER
+ * @return  unsigned long: elapsed simulated cycles
+ */
+unsigned long hostProbeElapsed(int timer)
+{
+    int irqClass = (timer == PROBE_KERNEL_TIMER) ? IRQ_KERNEL_AWARE : IRQ_ZERO_LATENCY;
+
+    return hostCycleCount() - probeArrival[irqClass];
+}
+
+/*
+ * @brief   Starts the interval timer standing in for a probe timer if
+ *          initLatencyProbes() enabled it, at the period it programmed
+ * @param   [in] int timer: probe timer
+ *          [in] int which: ITIMER_VIRTUAL or ITIMER_PROF
+ *          [in] int signalNumber: signal that timer raises
+ *          [in] void (*handler)(int): its handler
+ */
+static void startProbe(int timer, int which, int signalNumber, void (*handler)(int))
+{
+    struct sigaction action;
+    struct itimerval period;
+    unsigned long microseconds = ((TIMER_TAILR_R(timer) + 1) * MICROSECONDS) / HOST_CPU_HZ;
+
+    if(!(TIMER_CTL_R(timer) & TIMER_CTL_TAEN))
+    {
+        return;
+    }
+
+    action.sa_handler = handler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(signalNumber, &action, NULL);
+
+    period.it_interval.tv_sec = microseconds / MICROSECONDS;
+    period.it_interval.tv_usec = (microseconds % MICROSECONDS) ? microseconds % MICROSECONDS : 1;
+    period.it_value = period.it_interval;
+    setitimer(which, &period, NULL);
+}
+
+/*
+ * @brief   Starts the interval timer at the period programmed into the
+ *          simulated SysTick reload register
+ */
+static void startTicks(void)
+{
+    struct sigaction action;
+    struct itimerval period;
+    unsigned long microseconds = ((ST_RELOAD_R + 1) * MICROSECONDS) / HOST_CPU_HZ;
+    char * limit = getenv(HOST_TICKS_ENV);
+
+    if(limit)
+    {
+        tickLimit = strtoul(limit, NULL, 0);
+    }
+
+    action.sa_sigaction = tickHandler;
+    action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGALRM, &action, NULL);
+
+    period.it_interval.tv_sec = microseconds / MICROSECONDS;
+    period.it_interval.tv_usec = (microseconds % MICROSECONDS) ? microseconds % MICROSECONDS : 1;
+    period.it_value = period.it_interval;
+    setitimer(ITIMER_REAL, &period, NULL);
+
+    startProbe(PROBE_KERNEL_TIMER, ITIMER_VIRTUAL, SIGVTALRM, probeKernelSignal);
+    startProbe(PROBE_ZERO_TIMER, ITIMER_PROF, SIGPROF, probeZeroSignal);
+}
+
+/*
+ * @brief   Stands in for "SVC #0": calls SVCHandler with a stack frame
+ *          whose r7 holds the kernel arguments, then performs the
+ *          exception return. The first call (from main) starts SysTick
+ *          and never returns.
+ */
+void hostSVC(void)
+{
+    StackFrame frame;
+    int terminating;
+
+    inKernel = TRUE;
+    terminating = (current && (((KernelArgs *)hostR7)->code == TERMINATE));
+
+    frame.r7 = hostR7;
+    SVCHandler(&frame);
+
+    if(terminating)
+    {
+        current->dead = TRUE;
+    }
+    if(!current)
+    {
+        startTicks();
+    }
+
+    exceptionReturn();
+    inKernel = FALSE;
+    takeProbe();
+}
+
+/*
+ * @brief   Masks the simulated SysTick (cpsid i)
+ */
+void hostDisable(void)
+{
+    masked = TRUE;
+}
+
+/*
+ * @brief   Unmasks the simulated SysTick (cpsie i), taking a tick that
+ *          arrived while masked
+ */
+void hostEnable(void)
+{
+    masked = FALSE;
+    if((tickPending || probePending || linkPending) && current && !inKernel)
+    {
+        inKernel = TRUE;
+        exceptionReturn();
+        inKernel = FALSE;
+    }
+}
+
+/*
+ * @brief   Sets the simulated BASEPRI. The host has no zero-latency
+ *          interrupts other than the probe, so any non-zero value masks
+ *          the simulated kernel-aware ones as disable() does.
+ * @param   [in] unsigned long value: BASEPRI value, 0 masks nothing
+ */
+void hostSetBasePri(unsigned long value)
+{
+    if(value)
+    {
+        hostDisable();
+    }
+    else
+    {
+        hostEnable();
+    }
+}
@@ -14,6 +14,14 @@
 #include "Process.h"
 #include "SYSTICK.h"
 #include "Messages.h"
+#include "DWT.h"
+#include "Benchmark.h"
+#include "Timer.h"
+#include "Interrupts.h"
+#include "Spawn.h"
+#include "Rpc.h"
+#include "Names.h"
+#include "Bridge.h"
 
 /*
  * @brief   definition of idleProcess; the first process registered
@@ -34,7 +42,7 @@ void Priority3Process10(void)
     int mailBox = bind(ANY);
     int myID = getid();
     char cursorPosition[CURSOR_STRING];
-    char idString[POSITION_DIGITS];
+    char idString[POSITION_DIGITS + 1];
     getProcessCursor(myID,cursorPosition);
     formatLineNumber(myID, idString);
     sendMessage(UART_MB, mailBox, cursorPosition, CURSOR_STRING);
@@ -43,16 +51,20 @@ void Priority3Process10(void)
     sendMessage(UART_MB, mailBox, CLEAR_MODE, strlen(CLEAR_MODE) + 1);
     sendMessage(UART_MB, mailBox, "  ", 3);
     int i = 0;
-    int toMB =3;
+    int serverMB;
     int size = 9;
     char cont[9];
     nice(2);
     nice(3);
+    /* Wait for process 20 to name its mailbox */
+    while((serverMB = lookupName("greeter")) < 0)
+    {
+        nice(3);
+    }
     while (i < 5)
     {
         strcpy(cont, " *hi 20*\0");
-        sendMessage(toMB, mailBox, cont, size);
-        recvMessage(mailBox, &toMB, cont, size);
+        rpcCall(serverMB, cont, size, cont, size);
         getProcessCursor(myID,cursorPosition);
         sendMessage(UART_MB, mailBox, cursorPosition, CURSOR_STRING);
         sendMessage(UART_MB, mailBox, cont, size);
@@ -64,10 +76,11 @@ void Priority3Process10(void)
 
 void Priority3Process20(void)
 {
-    int mailBox = bind(3);
+    int mailBox = bind(ANY);
+    registerName("greeter", mailBox);
     int myID = getid();
     char cursorPosition[CURSOR_STRING];
-    char idString[POSITION_DIGITS];
+    char idString[POSITION_DIGITS + 1];
     getProcessCursor(myID, cursorPosition);
     formatLineNumber(myID, idString);
     sendMessage(UART_MB, mailBox, cursorPosition, CURSOR_STRING);
@@ -76,18 +89,18 @@ void Priority3Process20(void)
     sendMessage(UART_MB, mailBox, CLEAR_MODE, strlen(CLEAR_MODE) + 1);
     sendMessage(UART_MB, mailBox, "  ", 3);
     int i=0;
-    int toMB;
+    int callId;
     int size = 9;
     char cont[9];
 
     while (i < 5)
     {
-        recvMessage(mailBox, &toMB, cont, size);
+        rpcReceive(mailBox, &callId, cont, size);
         getProcessCursor(myID,cursorPosition);
         sendMessage(UART_MB, mailBox, cursorPosition, CURSOR_STRING);
         sendMessage(UART_MB, mailBox, cont, size);
         strcpy(cont, " *hi 10*\0");
-        sendMessage(toMB, mailBox, cont, size);
+        rpcReply(callId, cont, size);
         i++;
     }
 
@@ -106,27 +119,42 @@ int main(void)
     initMessagePool();
     initMailBoxList();
     initReceiveLogs();
+    initTimers();
+    initProcessPool();
+    initNames();
 
     int registerResult = 0;
 
     /* Register idle process first */
     registerResult |= registerProcess(idleProcess, 0, 0);
+
+#ifdef KERNEL_BENCHMARK
+    /* Benchmark suite reports directly to UART0 */
+    registerResult |= registerBenchmarks();
+#else
     registerResult |= registerProcess(uartProcess, 1, 4);
 
     /* Register other test processes */
     registerResult |= registerProcess(Priority3Process10, 10, 3);
     registerResult |= registerProcess(Priority3Process20, 20, 3);
+#endif
 
 
     if (!registerResult)
     {
         /* Initialize required hardware + interrupts */
         initpendSV();
+        initCycleCounter();     // Start DWT cycle counter for timestamps
         UART0_Init();           // Initialize UART0
+        setInterruptPriority(INT_VEC_UART0, KERNEL_IRQ_LEVEL);
         InterruptEnable(INT_VEC_UART0);       // Enable UART0 interrupts
         UART0_IntEnable(UART_INT_RX | UART_INT_TX); // Enable Receive and Transmit interrupts
         SysTickPeriod(HUNDREDTH_WAIT);
         SysTickIntEnable();
+#ifdef KERNEL_BENCHMARK
+        initLatencyProbes();    // Interrupt latency of each class
+        bridgeInit(TRUE);       // Bridge test link looped back
+#endif
         char *clearString = CLEAR_SCREEN;
         while (*clearString)
         {
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""
+@file    console_decode.py
+@brief   Renders a binary console capture (Console.h) as the text the
+         console would have written in text mode
+
+         Records are COBS encoded and end with a zero byte; each is
+             type timestamp(4, little endian) payload
+         Messages to the UART process are written unchanged, text lines
+         as they are, benchmark results as BENCH lines and trace records
+         as a traceDump() text dump, so bench greps, trace_to_chrome.py
+         and profile.py read the output as they would a text capture.
+         --records lists one line per record with its timestamp instead.
+         Input is decoded as it arrives, so a live serial port can be
+         read directly.
+
+usage:   console_decode.py [--records] [capture.bin]
+         host/benchmark-binary | console_decode.py | grep BENCH
+"""
+import argparse
+import struct
+import sys
+
+# Must match enum consolerecords in Console.h
+CONSOLE_TEXT_LINE, CONSOLE_MESSAGE, CONSOLE_BENCH, CONSOLE_TRACE = range(1, 5)
+RECORD_NAMES = {CONSOLE_TEXT_LINE: "text", CONSOLE_MESSAGE: "message",
+                CONSOLE_BENCH: "bench", CONSOLE_TRACE: "trace"}
+HEADER_FORMAT = "<BI"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+TRACE_HEADER_FORMAT = "<II"
+TRACE_EVENT_FORMAT = "<IBBH"
+COBS_BLOCK = 0xFF
+NUMBER_MORE = 0x80
+BENCH_FIELDS = 5
+
+
+def cobs_decode(frame):
+    """Returns the record encoded in frame, without its zero delimiter"""
+    data = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame):
+            raise ValueError("bad COBS code")
+        data += frame[i + 1:i + code]
+        i += code
+        if code != COBS_BLOCK and i < len(frame):
+            data.append(0)
+    return bytes(data)
+
+
+def read_number(payload, offset):
+    """Returns (value, next offset) of a number written by consoleNumber()"""
+    value = 0
+    shift = 0
+    while True:
+        if offset >= len(payload):
+            raise ValueError("truncated number")
+        group = payload[offset]
+        offset += 1
+        value |= (group & (NUMBER_MORE - 1)) << shift
+        shift += 7
+        if not group & NUMBER_MORE:
+            return value, offset
+
+
+def read_messages(payload):
+    """Returns the messages of a CONSOLE_MESSAGE record, after its sender"""
+    messages = []
+    offset = 2
+    while offset < len(payload):
+        size, offset = read_number(payload, offset)
+        if offset + size > len(payload):
+            raise ValueError("truncated message")
+        messages.append(payload[offset:offset + size])
+        offset += size
+    return messages
+
+
+def render_bench(payload):
+    fields = []
+    offset = 0
+    for _ in range(BENCH_FIELDS):
+        value, offset = read_number(payload, offset)
+        fields.append(value)
+    name = payload[offset:].decode("ascii", "replace")
+    return "BENCH,%s,%d,%d,%d,%d,%d\r\n" % ((name,) + tuple(fields))
+
+
+def render_trace(payload):
+    head, count = struct.unpack_from(TRACE_HEADER_FORMAT, payload)
+    lines = ["\r\nTRACE %08x %08x\n" % (head, count)]
+    for offset in range(struct.calcsize(TRACE_HEADER_FORMAT), len(payload),
+                        struct.calcsize(TRACE_EVENT_FORMAT)):
+        timestamp, kind, arg, pid = struct.unpack_from(TRACE_EVENT_FORMAT, payload, offset)
+        lines.append("%08x %02x %04x %02x\n" % (timestamp, kind, pid, arg))
+    lines.append("END\n")
+    return "".join(lines)
+
+
+def render(kind, payload):
+    """Returns the text mode output of a record"""
+    if kind == CONSOLE_TEXT_LINE:
+        return payload.decode("latin-1")
+    if kind == CONSOLE_MESSAGE:
+        # The UART process prints each message up to its first NUL
+        return "".join(message.split(b"\0", 1)[0].decode("latin-1")
+                       for message in read_messages(payload))
+    if kind == CONSOLE_BENCH:
+        return render_bench(payload)
+    if kind == CONSOLE_TRACE:
+        return render_trace(payload)
+    raise ValueError("unknown record type %d" % kind)
+
+
+def describe(kind, timestamp, payload):
+    """Returns the --records line of a record"""
+    name = RECORD_NAMES.get(kind, "type%d" % kind)
+    if kind == CONSOLE_MESSAGE:
+        detail = "from %d %s" % (struct.unpack_from("<h", payload)[0],
+                                 " ".join(message.hex() for message in read_messages(payload)))
+    elif kind == CONSOLE_TEXT_LINE:
+        detail = repr(payload.decode("latin-1"))
+    elif kind == CONSOLE_BENCH:
+        detail = render_bench(payload).strip()
+    else:
+        detail = "%d bytes" % len(payload)
+    return "%10d %-7s %s\n" % (timestamp, name, detail)
+
+
+def decode(stream, out, records):
+    """Decodes records from stream as they arrive; returns the number
+    of frames that could not be decoded"""
+    pending = bytearray()
+    bad = 0
+    while True:
+        chunk = stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+        if not chunk:
+            break
+        pending += chunk
+        *frames, pending = pending.split(b"\0")
+        pending = bytearray(pending)
+        for frame in frames:
+            if not frame:
+                continue
+            try:
+                record = cobs_decode(frame)
+                if len(record) < HEADER_SIZE:
+                    raise ValueError("short record")
+                kind, timestamp = struct.unpack_from(HEADER_FORMAT, record)
+                payload = record[HEADER_SIZE:]
+                out.write(describe(kind, timestamp, payload) if records else render(kind, payload))
+            except (ValueError, struct.error) as error:
+                bad += 1
+                sys.stderr.write("console_decode: skipped frame: %s\n" % error)
+        out.flush()
+    return bad
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Text rendering of a binary console capture")
+    parser.add_argument("capture", nargs="?", help="binary capture, default stdin")
+    parser.add_argument("--records", action="store_true", help="list records with timestamps")
+    args = parser.parse_args()
+    # Messages are bytes; pass them through as they are
+    sys.stdout.reconfigure(encoding="latin-1")
+
+    stream = open(args.capture, "rb") if args.capture else sys.stdin.buffer
+    bad = 0
+    try:
+        bad = decode(stream, sys.stdout, args.records)
+    except BrokenPipeError:
+        pass
+    finally:
+        if args.capture:
+            stream.close()
+    sys.exit(1 if bad else 0)
+
+
+if __name__ == "__main__":
+    main()
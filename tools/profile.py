@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""
+@file    profile.py
+@brief   Turns a PC-sampling profile dump (Profile.c) into a flat
+         per-function profile using the symbols of the build
+
+         Symbols are read from either:
+           the CCS linker map (Debug/LightWeightMessagingKernel.map),
+             section "GLOBAL SYMBOLS: SORTED BY Symbol Address"
+           nm -n output of the host build (--nm); host PCs are profiled
+             relative to __executable_start
+
+         Samples are attributed to the function containing the start of
+         their histogram bucket, so functions shorter than a bucket
+         (2^shift bytes) may absorb their neighbours' samples.
+
+usage:   profile.py capture.txt Debug/LightWeightMessagingKernel.map
+         nm -n host/kernel > kernel.sym; profile.py --nm capture.txt kernel.sym
+"""
+import argparse
+import bisect
+import sys
+
+MAP_SECTION = "GLOBAL SYMBOLS: SORTED BY Symbol Address"
+THUMB_BIT = 1
+# Symbols the TI linker defines that are not code
+IGNORED_SYMBOLS = ("__", "_c_int00")
+
+
+def read_dump(path):
+    """Returns the header, bucket counts and per-pid samples of the last dump"""
+    header = None
+    buckets = {}
+    pids = {}
+    with open(path, "r", errors="replace") as dump:
+        for line in dump:
+            fields = line.split()
+            if not fields:
+                continue
+            if fields[0].endswith("PROFILE") and len(fields) == 7:
+                base, shift, count, samples, kernel, outside = (int(field, 16) for field in fields[1:])
+                header = {"base": base, "shift": shift, "buckets": count, "samples": samples,
+                          "kernel": kernel, "outside": outside}
+                buckets = {}
+                pids = {}
+            elif header is None:
+                continue
+            elif fields[0] == "B" and len(fields) == 3:
+                buckets[int(fields[1], 16)] = int(fields[2], 16)
+            elif fields[0] == "P" and len(fields) == 3:
+                pids[int(fields[1], 16)] = int(fields[2], 16)
+    if header is None:
+        sys.exit("no PROFILE dump found in %s" % path)
+    return header, buckets, pids
+
+
+def read_map(path):
+    """Returns sorted (address, name) pairs from a TI linker map"""
+    symbols = []
+    in_section = False
+    with open(path, "r", errors="replace") as linker_map:
+        for line in linker_map:
+            if line.startswith(MAP_SECTION):
+                in_section = True
+                continue
+            if not in_section:
+                continue
+            fields = line.split()
+            if len(fields) != 2:
+                continue
+            if fields[0].startswith("---") or fields[0] == "address":
+                continue
+            try:
+                address = int(fields[0], 16)
+            except ValueError:
+                # Next section of the map
+                break
+            if not fields[1].startswith(IGNORED_SYMBOLS):
+                symbols.append((address & ~THUMB_BIT, fields[1]))
+    return sorted(symbols)
+
+
+def read_nm(path):
+    """Returns sorted (address, name) pairs of text symbols from nm output,
+    and the address of the executable start the host profiles relative to"""
+    symbols = []
+    start = 0
+    with open(path, "r", errors="replace") as listing:
+        for line in listing:
+            fields = line.split()
+            if len(fields) != 3:
+                continue
+            if fields[2] == "__executable_start":
+                start = int(fields[0], 16)
+            elif fields[1] in "tT":
+                symbols.append((int(fields[0], 16), fields[2]))
+    return sorted(symbols), start
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flat profile from a kernel PC-sampling dump")
+    parser.add_argument("dump", help="UART capture containing profileDump() output")
+    parser.add_argument("symbols", help="linker map, or nm -n output with --nm")
+    parser.add_argument("--nm", action="store_true", help="symbols are nm -n output of the host build")
+    args = parser.parse_args()
+
+    header, buckets, pids = read_dump(args.dump)
+    if args.nm:
+        # Host buckets are relative to the executable start
+        symbols, base = read_nm(args.symbols)
+    else:
+        symbols, base = read_map(args.symbols), header["base"]
+    addresses = [address for address, _ in symbols]
+
+    functions = {}
+    for bucket, count in buckets.items():
+        address = base + (bucket << header["shift"])
+        index = bisect.bisect_right(addresses, address) - 1
+        name = symbols[index][1] if index >= 0 else "0x%08x" % address
+        functions[name] = functions.get(name, 0) + count
+
+    process_samples = sum(buckets.values()) + header["outside"]
+    total = max(header["samples"], 1)
+    print("%d samples: %d in processes, %d in kernel/interrupts, %d outside the histogram"
+          % (header["samples"], process_samples, header["kernel"], header["outside"]))
+    print()
+    print("%8s %7s  %s" % ("samples", "%", "function"))
+    for name, count in sorted(functions.items(), key=lambda item: -item[1]):
+        print("%8d %6.2f%%  %s" % (count, 100.0 * count / total, name))
+
+    print()
+    print("%8s %7s  %s" % ("samples", "%", "pid"))
+    for pid, count in sorted(pids.items(), key=lambda item: -item[1]):
+        print("%8d %6.2f%%  %d" % (count, 100.0 * count / total, pid))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""
+@file    schedulability.py
+@brief   Host side schedulability analysis of a process table, giving
+         the same report as schedulabilityReport() (Admission.c)
+
+         The table is read from either:
+           a CSV file, one timed process per line:
+             <pid>,<E|F>,<priority>,<period>,<wcet>,<deadline>
+             (priority is ignored for E; '#' starts a comment)
+           a UART capture of schedulabilityReport(); its SCHED,TASK
+             lines are re-analysed
+
+         All times are SysTick ticks. The arithmetic is integer and
+         matches the kernel's, so a set the kernel admits reports OK here.
+
+usage:   schedulability.py table.csv
+         schedulability.py capture.txt
+"""
+import argparse
+import sys
+
+# Must match EDF.h and Admission.h
+EDF_PRIORITY = 5
+DENSITY_SHIFT = 20
+DENSITY_ONE = 1 << DENSITY_SHIFT
+
+
+def read_table(path):
+    """Returns a list of task dicts from a CSV table or a report capture"""
+    tasks = []
+    with open(path, "r", errors="replace") as source:
+        lines = [line.strip() for line in source]
+    # A capture holds other UART output too; only its task lines are read
+    capture = any(line.startswith("SCHED,") for line in lines)
+    for line in lines:
+        if capture:
+            if not line.startswith("SCHED,TASK,"):
+                continue
+            fields = line.split(",")[2:8]
+        else:
+            line = line.split("#")[0].strip()
+            if not line:
+                continue
+            fields = [field.strip() for field in line.split(",")]
+        if len(fields) != 6:
+            sys.exit("bad table line: %s" % line)
+        pid, kind, priority, period, wcet, deadline = fields
+        if kind not in ("E", "F"):
+            sys.exit("bad class %s for pid %s" % (kind, pid))
+        tasks.append({"pid": int(pid),
+                      "priority": EDF_PRIORITY if kind == "E" else int(priority),
+                      "period": int(period), "wcet": int(wcet), "deadline": int(deadline)})
+    return tasks
+
+
+def response_time(tasks, task):
+    """Smallest fixed point of R = C + sum(ceil(R / Tj) * Cj), or the first
+    iterate past the deadline"""
+    response, previous = task["wcet"], 0
+    while response != previous and response <= task["deadline"]:
+        previous = response
+        response = task["wcet"]
+        for other in tasks:
+            if other is not task and other["priority"] >= task["priority"]:
+                response += -(-previous // other["period"]) * other["wcet"]
+    return response
+
+
+def analyse(tasks):
+    """Fills in response and schedulable; returns (all schedulable, density)"""
+    density = sum(-(-(task["wcet"] << DENSITY_SHIFT) // task["deadline"])
+                  for task in tasks if task["priority"] == EDF_PRIORITY)
+    density = min(density, DENSITY_ONE + 1)
+    for task in tasks:
+        if task["priority"] == EDF_PRIORITY:
+            task["response"] = 0
+            task["schedulable"] = density <= DENSITY_ONE
+        else:
+            task["response"] = response_time(tasks, task)
+            task["schedulable"] = task["response"] <= task["deadline"]
+    return all(task["schedulable"] for task in tasks), density
+
+
+def verdict(ok):
+    return "OK" if ok else "FAIL"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Schedulability report of a timed process table")
+    parser.add_argument("table", help="CSV process table or UART capture of schedulabilityReport()")
+    args = parser.parse_args()
+
+    tasks = read_table(args.table)
+    result, density = analyse(tasks)
+
+    print("SCHED,BEGIN,%d" % len(tasks))
+    for task in tasks:
+        print("SCHED,TASK,%d,%s,%d,%d,%d,%d,%d,%s"
+              % (task["pid"], "E" if task["priority"] == EDF_PRIORITY else "F", task["priority"],
+                 task["period"], task["wcet"], task["deadline"], task["response"],
+                 verdict(task["schedulable"])))
+    print("SCHED,EDF,%d,%s" % ((density * 1000 + DENSITY_ONE - 1) >> DENSITY_SHIFT,
+                               verdict(density <= DENSITY_ONE)))
+    print("SCHED,END,%s" % verdict(result))
+
+
+if __name__ == "__main__":
+    main()
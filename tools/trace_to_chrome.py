@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""
+@file    trace_to_chrome.py
+@brief   Converts a kernel trace dump (Trace.c) into Chrome trace-event
+         JSON, viewable in chrome://tracing or https://ui.perfetto.dev
+
+         Two input formats are accepted:
+           text   - UART capture of traceDump(); everything before the
+                    "TRACE" header line is ignored
+           binary - memory image of the traceLog structure saved from the
+                    debugger (little endian, 32-bit target)
+
+usage:   trace_to_chrome.py [--binary] [--hz 16000000] dump [-o out.json]
+"""
+import argparse
+import json
+import struct
+import sys
+
+TRACE_MAGIC = 0x54524345
+TRACE_BUFFER_SIZE = 256
+EVENT_FORMAT = "<IBBH"
+EVENT_SIZE = struct.calcsize(EVENT_FORMAT)
+
+TRACE_SWITCH, TRACE_SVC, TRACE_BLOCK, TRACE_WAKE, TRACE_BIND, TRACE_UNBIND = range(6)
+
+# Must match enum kernelcallcodes in KernelCall.h
+KERNEL_CALLS = ["GETID", "NICE", "SENDMSG", "RECEIVEMSG", "TERMINATE", "BIND", "UNBIND", "GETSTATS", "GETLATENCY",
+                "GETMBSTATS", "GETPOOLSTATS", "GETPROFILE", "MBCONTROL", "WAITPERIOD", "TIMERSTART", "TIMERCANCEL",
+                "SCHEDMODE", "GETIRQLATENCY", "SPAWN",
+                "JOIN", "CHANNELBLOCK", "CHANNELWAKE", "RPCCALL", "RPCSEND", "RPCWAIT", "RPCREPLY",
+                "NAMEREGISTER", "NAMELOOKUP", "EVENTSET", "EVENTWAIT",
+                "SEMBLOCK", "SEMWAKE", "MUTEXBLOCK", "MUTEXWAKE", "POLLMSG"]
+
+
+def read_text(path):
+    """Returns the list of (timestamp, type, pid, arg) from a UART capture"""
+    events = []
+    in_trace = False
+    with open(path, "r", errors="replace") as dump:
+        for line in dump:
+            fields = line.split()
+            if not fields:
+                continue
+            if fields[0].endswith("TRACE"):
+                in_trace = True
+                events = []
+                continue
+            if not in_trace:
+                continue
+            if fields[0] == "END":
+                in_trace = False
+                continue
+            if len(fields) != 4:
+                continue
+            events.append(tuple(int(field, 16) for field in fields))
+    return events
+
+
+def read_binary(path):
+    """Returns the list of (timestamp, type, pid, arg) from a traceLog image"""
+    with open(path, "rb") as dump:
+        image = dump.read()
+
+    offset = image.find(struct.pack("<I", TRACE_MAGIC))
+    if offset < 0:
+        sys.exit("trace magic not found in %s" % path)
+
+    head, = struct.unpack_from("<I", image, offset + 4)
+    base = offset + 8
+    count = min(head, TRACE_BUFFER_SIZE)
+    events = []
+    for i in range(head - count, head):
+        slot = i % TRACE_BUFFER_SIZE
+        timestamp, kind, arg, pid = struct.unpack_from(EVENT_FORMAT, image, base + slot * EVENT_SIZE)
+        events.append((timestamp, kind, pid, arg))
+    return events
+
+
+def unwrap(events):
+    """Extends the 32-bit cycle counter so timestamps are monotonic"""
+    extended = []
+    high = 0
+    last = None
+    for timestamp, kind, pid, arg in events:
+        if last is not None and timestamp < last:
+            high += 1 << 32
+        last = timestamp
+        extended.append((high + timestamp, kind, pid, arg))
+    return extended
+
+
+def to_chrome(events, hz):
+    """Builds the trace-event list: one slice per on-CPU interval, instants for the rest"""
+    scale = 1e6 / hz
+    chrome = []
+    running = None
+    since = None
+    pids = set()
+
+    for cycles, kind, pid, arg in events:
+        ts = cycles * scale
+        pids.add(pid)
+        if kind == TRACE_SWITCH:
+            if running is not None:
+                chrome.append({"name": "pid %d" % running, "ph": "X", "pid": 0, "tid": running,
+                               "ts": since, "dur": ts - since})
+            running, since = pid, ts
+        elif kind == TRACE_SVC:
+            name = KERNEL_CALLS[arg] if arg < len(KERNEL_CALLS) else "SVC %d" % arg
+            chrome.append({"name": name, "ph": "i", "s": "t", "pid": 0, "tid": pid, "ts": ts})
+        elif kind == TRACE_BLOCK:
+            chrome.append({"name": "block mb %d" % arg, "ph": "i", "s": "t", "pid": 0, "tid": pid, "ts": ts})
+        elif kind == TRACE_WAKE:
+            chrome.append({"name": "wake mb %d" % arg, "ph": "i", "s": "t", "pid": 0, "tid": pid, "ts": ts})
+        elif kind == TRACE_BIND:
+            chrome.append({"name": "bind mb %d" % arg, "ph": "i", "s": "t", "pid": 0, "tid": pid, "ts": ts})
+        elif kind == TRACE_UNBIND:
+            chrome.append({"name": "unbind mb %d" % arg, "ph": "i", "s": "t", "pid": 0, "tid": pid, "ts": ts})
+
+    for pid in sorted(pids):
+        chrome.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": pid,
+                       "args": {"name": "process %d" % pid}})
+    return chrome
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a kernel trace dump to Chrome trace JSON")
+    parser.add_argument("dump", help="UART capture or traceLog memory image")
+    parser.add_argument("--binary", action="store_true", help="dump is a binary memory image")
+    parser.add_argument("--hz", type=float, default=16e6, help="core clock in Hz (default 16 MHz)")
+    parser.add_argument("-o", "--output", help="output file (default stdout)")
+    args = parser.parse_args()
+
+    events = read_binary(args.dump) if args.binary else read_text(args.dump)
+    chrome = to_chrome(unwrap(events), args.hz)
+
+    output = open(args.output, "w") if args.output else sys.stdout
+    json.dump({"traceEvents": chrome, "displayTimeUnit": "ns"}, output, indent=1)
+    output.write("\n")
+
+
+if __name__ == "__main__":
+    main()